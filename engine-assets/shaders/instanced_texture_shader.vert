@@ -0,0 +1,26 @@
+#version 330 core
+
+// one sprite per instance, the quad corners come from the vertex id of a 4 vertex triangle strip
+layout(location = 0) in vec4 instanceRect;
+layout(location = 1) in vec4 instanceColor;
+layout(location = 2) in vec4 instanceUV;
+layout(location = 3) in uint instanceTextureSlot;
+
+layout(location = 0) out vec4 fragmentColor;
+layout(location = 1) out vec2 fragmentUV;
+layout(location = 2) flat out uint fragmentTextureSlot;
+
+uniform mat4 u_mvpMatrix;
+
+void main() {
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+	vec2 position = mix(instanceRect.xy, instanceRect.zw, corner);
+	vec2 uv = instanceUV.xy + instanceUV.zw * corner;
+
+	gl_Position = u_mvpMatrix * vec4(position, 0.0, 1.0);
+
+	fragmentColor = instanceColor;
+	fragmentUV = vec2(uv.x, 1.0 - uv.y);
+	fragmentTextureSlot = instanceTextureSlot;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#version 330 core
+
+layout(location = 0) in vec4 fragmentColor;
+layout(location = 1) in vec2 fragmentUV;
+layout(location = 2) flat in uint fragmentTextureSlot;
+
+layout(location = 0) out vec4 finalColor;
+
+uniform sampler2D u_imageSamplers[16];
+
+// glsl 3.30 only allows indexing sampler arrays with constant expressions,
+// the gradients are passed in as they are undefined inside non uniform control flow
+vec4 sampleSlot(uint slot, vec2 uv, vec2 dx, vec2 dy) {
+	switch (slot) {
+	case 0u: return textureGrad(u_imageSamplers[0], uv, dx, dy);
+	case 1u: return textureGrad(u_imageSamplers[1], uv, dx, dy);
+	case 2u: return textureGrad(u_imageSamplers[2], uv, dx, dy);
+	case 3u: return textureGrad(u_imageSamplers[3], uv, dx, dy);
+	case 4u: return textureGrad(u_imageSamplers[4], uv, dx, dy);
+	case 5u: return textureGrad(u_imageSamplers[5], uv, dx, dy);
+	case 6u: return textureGrad(u_imageSamplers[6], uv, dx, dy);
+	case 7u: return textureGrad(u_imageSamplers[7], uv, dx, dy);
+	case 8u: return textureGrad(u_imageSamplers[8], uv, dx, dy);
+	case 9u: return textureGrad(u_imageSamplers[9], uv, dx, dy);
+	case 10u: return textureGrad(u_imageSamplers[10], uv, dx, dy);
+	case 11u: return textureGrad(u_imageSamplers[11], uv, dx, dy);
+	case 12u: return textureGrad(u_imageSamplers[12], uv, dx, dy);
+	case 13u: return textureGrad(u_imageSamplers[13], uv, dx, dy);
+	case 14u: return textureGrad(u_imageSamplers[14], uv, dx, dy);
+	case 15u: return textureGrad(u_imageSamplers[15], uv, dx, dy);
+	}
+	return vec4(0.0);
+}
+
+void main() {
+	vec2 dx = dFdx(fragmentUV);
+	vec2 dy = dFdy(fragmentUV);
+
+	finalColor = sampleSlot(fragmentTextureSlot, fragmentUV, dx, dy) * fragmentColor;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#version 330 core
+
+layout(location = 0) in vec4 fragmentColor;
+layout(location = 1) in vec2 fragmentLocalPos;
+
+// half width, half height, corner radius, outline thickness
+layout(location = 2) flat in vec4 fragmentShape;
+
+layout(location = 0) out vec4 finalColor;
+
+// distance to a box with rounded corners, negative inside
+float roundedBoxDistance(vec2 pos, vec2 halfSize, float cornerRadius) {
+	vec2 q = abs(pos) - halfSize + cornerRadius;
+	return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - cornerRadius;
+}
+
+void main() {
+	float dist = roundedBoxDistance(fragmentLocalPos, fragmentShape.xy, fragmentShape.z);
+
+	// an outline keeps only the band of the given thickness inside the edge
+	float outline = fragmentShape.w;
+	if (outline > 0.0) {
+		dist = abs(dist + outline * 0.5) - outline * 0.5;
+	}
+
+	// fade over about one pixel across the edge
+	float coverage = clamp(0.5 - dist / max(fwidth(dist), 0.0001), 0.0, 1.0);
+
+	if (coverage <= 0.0) {
+		discard;
+	}
+
+	finalColor = vec4(fragmentColor.rgb, fragmentColor.a * coverage);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#version 330 core
+
+layout(location = 0) in vec4 fragmentColor;
+layout(location = 1) in vec2 fragmentUV;
+
+layout(location = 0) out vec4 finalColor;
+
+uniform sampler2D u_imageSampler;
+
+// distance in glyph pixels that the 0 to 1 range of the texture spans on each side of the edge
+uniform float u_sdfSpread;
+
+// outline width in glyph pixels, 0 for no outline
+uniform float u_outlineWidth;
+uniform vec4 u_outlineColor;
+
+// shadow offset in glyph pixels with y going down, a transparent color for no shadow
+uniform vec2 u_shadowOffset;
+uniform float u_shadowSoftness;
+uniform vec4 u_shadowColor;
+
+// signed distance to the glyph's edge in glyph pixels, positive inside
+float glyphDistance(vec2 uv) {
+	// the edge is stored as 128 out of 255
+	return (texture(u_imageSampler, uv).r * 255.0 - 128.0) / 128.0 * u_sdfSpread;
+}
+
+void main() {
+	float dist = glyphDistance(fragmentUV);
+
+	// fade over about one screen pixel across the edge, at any scale
+	float edgeWidth = max(fwidth(dist), 0.0001);
+
+	float fill = clamp(dist / edgeWidth + 0.5, 0.0, 1.0);
+
+	vec4 color = vec4(fragmentColor.rgb, fragmentColor.a * fill);
+
+	if (u_outlineWidth > 0.0) {
+		float outline = clamp((dist + u_outlineWidth) / edgeWidth + 0.5, 0.0, 1.0);
+
+		color = mix(u_outlineColor, fragmentColor, fill);
+		color.a *= outline;
+	}
+
+	if (u_shadowColor.a > 0.0) {
+		vec2 shadowUV = fragmentUV - u_shadowOffset / vec2(textureSize(u_imageSampler, 0));
+
+		// the shadow is cast by the outline too
+		float shadowDist = glyphDistance(shadowUV) + u_outlineWidth;
+		float shadowWidth = max(edgeWidth, u_shadowSoftness);
+
+		float shadowAlpha = u_shadowColor.a * clamp(shadowDist / shadowWidth + 0.5, 0.0, 1.0);
+
+		// the text is drawn over its shadow
+		float alpha = color.a + shadowAlpha * (1.0 - color.a);
+		vec3 rgb = (color.rgb * color.a + u_shadowColor.rgb * shadowAlpha * (1.0 - color.a)) / max(alpha, 0.0001);
+
+		color = vec4(rgb, alpha);
+	}
+
+	if (color.a <= 0.0) {
+		discard;
+	}
+
+	finalColor = color;
+}
\ No newline at end of file
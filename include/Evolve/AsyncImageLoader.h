@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "ImageLoader.h"
+#include "TextureHandle.h"
+#include "StringId.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// decodes images on a pool of worker threads while the game keeps running
+	// gl calls only happen in processUploads, which must be called on the gl thread, usually once per frame
+	class AsyncImageLoader {
+	public:
+		AsyncImageLoader();
+		~AsyncImageLoader();
+
+		// 0 threads uses one less than the number of cores, but at least one
+		bool init(unsigned int numThreads = 0);
+
+		// requesting a path that is still requested returns the same handle, 
+		// requesting it with other color channels is an error, a failed load is retried by the next request
+		TextureHandle loadTexture(const std::string& imagePath, const unsigned int colorChannels);
+
+		// empties the handle, the texture is deleted once every handle to it is released,
+		// if it's still loading that happens right after it's uploaded, must be called on the gl thread
+		void releaseTexture(TextureHandle& handle);
+
+		// uploads decoded images until the budget is spent, at least one is uploaded per call if any are waiting
+		void processUploads(const double budgetMilliseconds = 2.0);
+
+		// images waiting to be decoded or uploaded
+		size_t getNumPending() const { return numPending_.load(std::memory_order_relaxed); }
+
+		// stops the workers and deletes the textures this loader uploaded, the handles stay valid but fail
+		void freeAsyncImageLoader();
+
+	private:
+		using StatePtr = std::shared_ptr<TextureHandle::State>;
+
+		bool inited_ = false;
+
+		std::vector<std::thread> workers_;
+
+		// decode jobs, guarded by jobsMutex_
+		std::deque<StatePtr> jobs_;
+		std::mutex jobsMutex_;
+		std::condition_variable jobsCondition_;
+		bool stopping_ = false;
+
+		// decoded images waiting for the gl thread, guarded by uploadsMutex_
+		std::deque<StatePtr> uploads_;
+		std::mutex uploadsMutex_;
+
+		// every request by path, so duplicate requests coalesce, guarded by requestsMutex_
+		FlatHashMap<StringId, StatePtr, StringIdHash> requests_;
+		std::mutex requestsMutex_;
+
+		std::atomic<size_t> numPending_ { 0 };
+
+		void workerLoop();
+
+		// forgets the request and deletes its texture if the caller and the map hold the only references
+		void releaseIfUnused(StatePtr& state);
+	};
+}
\ No newline at end of file
@@ -23,6 +23,7 @@ SOFTWARE.
 #pragma once
 
 #include "IncludeLibs.h"
+#include "StringId.h"
 #include "ErrorReporter.h"
 
 namespace Evolve {
@@ -76,7 +77,8 @@ namespace Evolve {
 		std::vector<Mix_Chunk*> soundEffects_;
 		std::vector<Mix_Music*> musics_;
 
-		std::map<std::string, std::pair<Mix_Chunk*, size_t>> soundEffectCache_;
-		std::map<std::string, std::pair<Mix_Music*, size_t>> musicCache_;
+		// ids of the loaded files by path
+		FlatHashMap<StringId, size_t, StringIdHash> soundEffectCache_;
+		FlatHashMap<StringId, size_t, StringIdHash> musicCache_;
 	};
 }
@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "BakedAtlasFormat.h"
+#include "MappedFile.h"
+#include "TextureAtlas.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// an atlas packed offline by the atlas baker tool
+	// the file is memory mapped and its pages are uploaded straight from the mapping, 
+	// there's no image decoding at load time
+	class BakedAtlas {
+	public:
+		BakedAtlas();
+		~BakedAtlas();
+
+		bool loadFromFile(const std::string& filePath);
+
+		// returns false if there's no sprite with the name
+		bool getRegion(const std::string& name, AtlasRegion& region) const;
+
+		size_t getNumPages() const { return pageTextureIDs_.size(); }
+		GLuint getPageTextureID(const unsigned int page) const;
+
+		void freeBakedAtlas();
+
+		// checks that the header, tables and levels of a mapped baked file lie within it
+		static bool validateFile(const MappedFile& file, const std::string& filePath);
+
+	private:
+		std::vector<GLuint> pageTextureIDs_;
+		std::unordered_map<std::string, AtlasRegion> regions_;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace Evolve {
+
+	// layout of a baked atlas file, written by the atlas baker tool and read by BakedAtlas
+	// the file is the header, the sprite table, the sprite names, the level table, 
+	// then the pixels of every mip level of every page, each level aligned to BAKED_ATLAS_ALIGNMENT
+	// all values are little endian
+
+	const char BAKED_ATLAS_MAGIC[4] = { 'E', 'V', 'B', 'A' };
+	const uint32_t BAKED_ATLAS_VERSION = 1;
+	const uint64_t BAKED_ATLAS_ALIGNMENT = 16;
+
+	struct BakedAtlasHeader {
+		char Magic[4];
+		uint32_t Version;
+		uint32_t PageWidth, PageHeight;
+		uint32_t ColorChannels;
+
+		// 1 if the pages have no mipmaps
+		uint32_t NumMipLevels;
+		uint32_t NumPages;
+		uint32_t NumSprites;
+
+		uint64_t SpriteTableOffset;
+		uint64_t NameBlobOffset, NameBlobSize;
+
+		// NumPages * NumMipLevels entries, the levels of a page are consecutive
+		uint64_t LevelTableOffset;
+	};
+
+	struct BakedAtlasSprite {
+		// the name is not null terminated
+		uint32_t NameOffset, NameLength;
+		uint32_t Page;
+
+		// position in the page in pixels, from the top left
+		int32_t X, Y, Width, Height;
+	};
+
+	struct BakedAtlasLevel {
+		uint64_t Offset, Size;
+		uint32_t Width, Height;
+	};
+
+	static_assert(sizeof(BakedAtlasHeader) == 64, "Baked atlas header must be packed.");
+	static_assert(sizeof(BakedAtlasSprite) == 28, "Baked atlas sprite must be packed.");
+	static_assert(sizeof(BakedAtlasLevel) == 24, "Baked atlas level must be packed.");
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+namespace Evolve {
+
+	// a hash map storing its entries in one array with linear probing, 
+	// meant for small keys like ids and pointers looked up every frame
+	// inserting or erasing may move the entries, so pointers to values are only valid until then
+	template <typename Key, typename Value, typename Hash = std::hash<Key>>
+	class FlatHashMap {
+	public:
+		FlatHashMap() {};
+		~FlatHashMap() {};
+
+		// returns nullptr if the key isn't in the map
+		Value* find(const Key& key) {
+			size_t index = findIndex(key);
+			return index != NOT_FOUND ? &slots_[index].Entry.second : nullptr;
+		}
+
+		const Value* find(const Key& key) const {
+			size_t index = findIndex(key);
+			return index != NOT_FOUND ? &slots_[index].Entry.second : nullptr;
+		}
+
+		bool contains(const Key& key) const { return findIndex(key) != NOT_FOUND; }
+
+		// inserts a default constructed value if the key isn't in the map, the bool is true if it was inserted
+		std::pair<Value*, bool> tryEmplace(const Key& key) {
+			if ((numEntries_ + 1) * MAX_LOAD_DENOMINATOR > slots_.size() * MAX_LOAD_NUMERATOR) {
+				rehash(std::max<size_t>(MIN_CAPACITY, slots_.size() * 2));
+			}
+
+			size_t mask = slots_.size() - 1;
+
+			for (size_t index = Hash()(key) & mask;; index = (index + 1) & mask) {
+				Slot& slot = slots_[index];
+
+				if (!slot.Occupied) {
+					slot.Occupied = true;
+					slot.Entry.first = key;
+					slot.Entry.second = Value();
+					numEntries_++;
+					return std::make_pair(&slot.Entry.second, true);
+				}
+
+				if (slot.Entry.first == key) {
+					return std::make_pair(&slot.Entry.second, false);
+				}
+			}
+		}
+
+		Value& operator[](const Key& key) { return *tryEmplace(key).first; }
+
+		// returns false if the key isn't in the map
+		bool erase(const Key& key) {
+			size_t index = findIndex(key);
+
+			if (index == NOT_FOUND) {
+				return false;
+			}
+
+			// shift the following entries of the probe sequence back, so lookups never need tombstones
+			size_t mask = slots_.size() - 1;
+			size_t hole = index;
+
+			for (size_t next = (hole + 1) & mask; slots_[next].Occupied; next = (next + 1) & mask) {
+				size_t home = Hash()(slots_[next].Entry.first) & mask;
+
+				// an entry can move into the hole only if the hole is between its home slot and its slot
+				if (((next - home) & mask) >= ((next - hole) & mask)) {
+					slots_[hole].Entry = std::move(slots_[next].Entry);
+					hole = next;
+				}
+			}
+
+			slots_[hole].Occupied = false;
+			slots_[hole].Entry = std::pair<Key, Value>();
+			numEntries_--;
+
+			return true;
+		}
+
+		// calls func(const Key&, Value&) for every entry, the map must not be changed meanwhile
+		template <typename Func>
+		void forEach(Func func) {
+			for (auto& slot : slots_) {
+				if (slot.Occupied) {
+					func((const Key&) slot.Entry.first, slot.Entry.second);
+				}
+			}
+		}
+
+		void reserve(const size_t numEntries) {
+			size_t capacity = MIN_CAPACITY;
+
+			while (numEntries * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR) {
+				capacity *= 2;
+			}
+
+			if (capacity > slots_.size()) {
+				rehash(capacity);
+			}
+		}
+
+		void clear() {
+			slots_.clear();
+			numEntries_ = 0;
+		}
+
+		size_t size() const { return numEntries_; }
+		bool empty() const { return numEntries_ == 0; }
+
+	private:
+		struct Slot {
+			std::pair<Key, Value> Entry;
+			bool Occupied = false;
+		};
+
+		static constexpr size_t NOT_FOUND = (size_t) -1;
+		static constexpr size_t MIN_CAPACITY = 16;
+
+		// the map grows when it's more than 7 / 10 full
+		static constexpr size_t MAX_LOAD_NUMERATOR = 7;
+		static constexpr size_t MAX_LOAD_DENOMINATOR = 10;
+
+		// the capacity is always 0 or a power of 2
+		std::vector<Slot> slots_;
+		size_t numEntries_ = 0;
+
+		size_t findIndex(const Key& key) const {
+			if (slots_.empty()) {
+				return NOT_FOUND;
+			}
+
+			size_t mask = slots_.size() - 1;
+
+			for (size_t index = Hash()(key) & mask; slots_[index].Occupied; index = (index + 1) & mask) {
+				if (slots_[index].Entry.first == key) {
+					return index;
+				}
+			}
+
+			return NOT_FOUND;
+		}
+
+		void rehash(const size_t capacity) {
+			std::vector<Slot> oldSlots;
+			oldSlots.swap(slots_);
+
+			slots_.resize(capacity);
+			numEntries_ = 0;
+
+			for (auto& slot : oldSlots) {
+				if (slot.Occupied) {
+					*tryEmplace(slot.Entry.first).first = std::move(slot.Entry.second);
+				}
+			}
+		}
+	};
+}
\ No newline at end of file
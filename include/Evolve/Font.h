@@ -29,12 +29,19 @@ SOFTWARE.
 #include "UvDimension.h"
 #include "ColorRgba.h"
 #include "TextureRenderer.h"
+#include "TextureAtlas.h"
+#include "FontFaceCache.h"
+#include "TextLayout.h"
+#include "FlatHashMap.h"
+#include "Utf8.h"
 #include "ErrorReporter.h"
 
 namespace Evolve {
 
 	class Font {
 	public:
+		friend class TextLayout;
+
 		Font();
 		~Font();
 
@@ -43,10 +50,31 @@ namespace Evolve {
 			const float fontScale = 1.0f, const int letterSpacing = 0,
 			const int lineSpacing = 0, const int addToSpaceLength = 0);
 
+		// glyphs are rasterized the first time they're drawn or measured and packed into an atlas,
+		// which gets a new page when the current ones are full
+		// fonts loaded from the same file share its face, see FontFaceCache
 		bool initFromFontFile(const char* fontName, const char* fontFilePath, const unsigned int fontSize = 32,
 			const float fontScale = 1.0f, const int letterSpacing = 0,
 			const int lineSpacing = 0, const int addToSpaceLength = 0);
 
+		// glyphs are rendered once as distance fields at the base size and stay sharp at any font scale,
+		// the text must be rendered with an SdfTextShader, which can also outline and shadow it
+		bool initSdfFromFontFile(const char* fontName, const char* fontFilePath, const unsigned int baseSize = 48,
+			const float fontScale = 1.0f, const int letterSpacing = 0,
+			const int lineSpacing = 0, const int addToSpaceLength = 0);
+
+		// loads fonts[i] at fontSizes[i], all from one opening of the file
+		static bool initSizesFromFontFile(const char* fontName, const char* fontFilePath,
+			const std::vector<Font*>& fonts, const std::vector<unsigned int>& fontSizes,
+			const float fontScale = 1.0f, const int letterSpacing = 0,
+			const int lineSpacing = 0, const int addToSpaceLength = 0);
+
+		// rasterizes the glyphs of the text ahead of time, so the first frame drawing it doesn't have to
+		void preloadGlyphs(const char* text) const;
+
+		// the texts are utf-8, a bitmap font only has the first 256 code points
+		// text drawn every frame is better kept in a TextLayout, which can also wrap and align it,
+		// this lays the text out again whenever it changes between calls
 		void drawTextToRenderer(const char* text, const int topLeftX, const int topLeftY,
 			const ColorRgba& color, TextureRenderer& textureRenderer) const;
 
@@ -59,17 +87,51 @@ namespace Evolve {
 		std::string getFontName() const { return fontName_; }
 
 		bool isInitialized() const { return initialized_; }
+		bool isSdf() const { return sdf_; }
+
+		// changes whenever the font is loaded, deleted or its spacing is changed, the scale is tracked apart
+		unsigned int getGeneration() const { return generation_; }
+		float getFontScale() const { return fontScale_; }
 
-		void setLetterSpacing(const int letterSpacing) { letterSpacing_ = letterSpacing; }
-		void setLineSpacing(const int lineSpacing) { lineSpacing_ = lineSpacing; }
-		void setAddToSpaceLength(const int addToSpaceLength) { addToSpaceLength_ = addToSpaceLength; }
+		void setLetterSpacing(const int letterSpacing) { letterSpacing_ = letterSpacing; newGeneration(); }
+		void setLineSpacing(const int lineSpacing) { lineSpacing_ = lineSpacing; newGeneration(); }
+		void setAddToSpaceLength(const int addToSpaceLength) { addToSpaceLength_ = addToSpaceLength; newGeneration(); }
 		void setFontScale(const float fontScale) { fontScale_ = fontScale; }
 
+		size_t getNumGlyphs() const { return glyphs_.size(); }
+		size_t getNumGlyphPages() const { return glyphAtlas_.getNumPages(); }
+
 		void deleteFont();
 
 	private:
+		struct Glyph {
+			// 0 for glyphs with nothing to draw, like spaces
+			GLuint TextureID = 0;
+			UvDimension Uv {};
+
+			int Width = 0, Height = 0;
+
+			// from the pen position to the top left of the glyph, y goes down from the top of the line
+			int OffsetX = 0, OffsetY = 0;
+
+			int Advance = 0;
+
+			// in the font file, for kerning
+			unsigned int GlyphIndex = 0;
+		};
+
+		struct KerningPairHash {
+			// the pair keys differ mostly in their high bits, which the table doesn't index by
+			size_t operator()(const uint64_t key) const {
+				uint64_t hash = key ^ (key >> 33);
+				hash *= 0xFF51AFD7ED558CCDull;
+				return (size_t) (hash ^ (hash >> 33));
+			}
+		};
+
 		const char* fontName_ = nullptr;
 		bool initialized_ = false;
+		bool sdf_ = false;
 
 		unsigned int spaceSize_ = 0;
 		unsigned int newLine_ = 0;
@@ -81,9 +143,39 @@ namespace Evolve {
 
 		float fontScale_ = 1.0f;
 
+		// unique across all fonts, so a layout can't mistake a new font at the same address for its old one
+		unsigned int generation_ = 0;
+		static unsigned int lastGeneration_;
+
+		// the layout of drawTextToRenderer
+		mutable TextLayout drawLayout_;
+
+		// distance from the top of the line to the baseline
+		int ascender_ = 0;
+
+		// the texture of a bitmap font
 		TextureData fontTexture_;
 
-		UvDimension uvDimensions_[256] {};
-		int characterWidths_[256] {};
+		// the face is shared with the other fonts of the file, the size is this font's own
+		FT_Face ftFace_ = nullptr;
+		FT_Size ftSize_ = nullptr;
+
+		// filled lazily while drawing and measuring, which are const
+		mutable TextureAtlas glyphAtlas_;
+		mutable FlatHashMap<uint32_t, Glyph> glyphs_;
+
+		// kerning of glyph index pairs in pixels, keyed by the left index in the high 32 bits
+		mutable FlatHashMap<uint64_t, int, KerningPairHash> kerningPairs_;
+
+		void newGeneration() { generation_ = ++lastGeneration_; }
+
+		// returns nullptr if the font has no glyph for the code point
+		const Glyph* getGlyph(const uint32_t codePoint) const;
+
+		// renders the glyph into the atlas, code points sharing a glyph share its pixels
+		void rasterizeGlyph(const unsigned int glyphIndex, Glyph& glyph) const;
+
+		// unscaled, 0 for bitmap fonts and fonts without kerning
+		int getKerning(const unsigned int leftGlyphIndex, const unsigned int rightGlyphIndex) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+#include FT_SIZES_H
+#include FT_MODULE_H
+
+// FT_RENDER_MODE_SDF was added in FreeType 2.11
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+#define EVOLVE_FREETYPE_SDF
+#endif
+
+#include "MappedFile.h"
+#include "FlatHashMap.h"
+#include "StringId.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// one FreeType library for the process and one face per font file, shared by every size loaded from it
+	// the files are memory mapped instead of read, each user of a face gets its own FT_Size
+	// FreeType faces aren't thread safe, so fonts must be loaded, drawn and deleted on one thread
+	class FontFaceCache {
+	public:
+		// returns the shared face of the file and a new size set to the pixel size, the size is not activated
+		static bool AcquireFace(const std::string& fontFilePath, const unsigned int pixelSize, 
+			FT_Face& face, FT_Size& size);
+
+		// frees the size, the face and its file are closed with its last size and the library with the last face
+		static void ReleaseFace(FT_Face face, FT_Size size);
+
+		static size_t GetNumFaces() { return faces_.size(); }
+
+		// distance in pixels from a glyph's edge covered by the distance fields FreeType renders
+		static const int SDF_SPREAD = 8;
+
+	private:
+		struct CachedFace {
+			FT_Face Face = nullptr;
+
+			// the face reads its glyphs from the mapping for as long as it lives
+			std::unique_ptr<MappedFile> File;
+
+			unsigned int Refs = 0;
+		};
+
+		static FT_Library library_;
+
+		// keyed by the interned paths
+		static FlatHashMap<StringId, CachedFace, StringIdHash> faces_;
+
+		static bool openFace(const std::string& fontFilePath, CachedFace& cachedFace);
+	};
+}
\ No newline at end of file
@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include "IncludeLibs.h"
 
+#include "StringId.h"
 #include "ErrorReporter.h"
 
 namespace Evolve {
@@ -34,6 +35,8 @@ namespace Evolve {
 		~GlslProgram();
 
 		bool compileAndLinkShaders(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
+		// looking up a uniform by a compile time id doesn't hash or copy its name
+		GLint getUniformLocation(const StringId& uniformId);
 		GLint getUniformLocation(const std::string& uniformName);
 		void useProgram();
 		void unuseProgram();
@@ -45,7 +48,7 @@ namespace Evolve {
 		GLuint vertexShaderID_ = 0;
 		GLuint fragmentShaderID_ = 0;
 
-		std::unordered_map<std::string, GLint> m_uniformCache;
+		FlatHashMap<StringId, GLint, StringIdHash> m_uniformCache;
 
 		// Compiles a single shader, return the shader id
 		// shaderType should be either GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
@@ -114,6 +114,9 @@ namespace Evolve {
 			int centerX_ = 0, centerY_ = 0;
 			int labelTopLeftX_ = 0, labelTopLeftY_ = 0;
 
+			// the label's quads, laid out again only when the label, its scale or its font changes
+			TextLayout labelLayout_;
+
 			float time_ = 0.0f;
 
 			bool isFunctional_ = true;
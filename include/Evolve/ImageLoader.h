@@ -26,22 +26,90 @@ SOFTWARE.
 
 #include "../Vendor/stb_image.h"
 #include "TextureData.h"
+#include "StringId.h"
+#include "PixelConverter.h"
 #include "ErrorReporter.h"
 
 namespace Evolve {
 
+	struct TextureCacheStats {
+		// loads that found the pixels and buffers that found the gl texture in the cache, and those that didn't
+		size_t Hits = 0, Misses = 0;
+
+		// pixel buffers and gl textures evicted to stay within the budgets
+		size_t Evictions = 0;
+
+		size_t ResidentCpuBytes = 0, ResidentGpuBytes = 0;
+		size_t NumEntries = 0;
+	};
+
+	// an optional conversion of loaded rgba pixels, applied in this order
+	struct ImageConversion {
+		bool Swizzle = false;
+		unsigned char SwizzleOrder[4] = { 0, 1, 2, 3 };
+
+		// textures with premultiplied alpha are drawn with TextureBlendMode::PREMULTIPLIED_ALPHA
+		bool PremultiplyAlpha = false;
+
+		// RGB565 and RGBA4444 halve the memory of the pixels and of the texture
+		TexturePixelFormat Format = TexturePixelFormat::BYTE_PER_CHANNEL;
+	};
+
+	// images loaded from files are cached by path, the cache owns their pixels and gl textures
+	// loading or buffering a cached image takes a reference, freeing or deleting it releases the reference,
+	// unreferenced pixels and textures stay cached until the cache goes over its budget, 
+	// then the least recently used ones are evicted
 	class ImageLoader {
 	public:
 
+		// safe to call from any thread, concurrent loads of the same path share one cache entry
 		static void LoadTextureFromImage(const std::string& imagePath, TextureData& texture,
 			const unsigned int colorChannels);
 
+		// must be called on the gl thread, a cached image that is already buffered reuses its texture
 		static void BufferTextureData(TextureData& texture);
 
+		// converts the pixels of a loaded rgba texture, must be called before buffering it,
+		// cached pixels are copied first, so the converted texture isn't cached and belongs to the caller
+		static void ConvertTexture(TextureData& texture, const ImageConversion& conversion);
+
 		static void FreeTexture(TextureData& texture);
+
+		// must be called on the gl thread
 		static void DeleteTexture(TextureData& texture);
 
+		// budgets in bytes of the cached pixels and of the cached gl textures, 
+		// the gpu budget is only enforced on the gl thread, when buffering or deleting
+		static void SetCacheBudgets(const size_t cpuBytes, const size_t gpuBytes);
+
+		static TextureCacheStats GetCacheStats();
+
 	private:
-		static std::map<std::string, TextureData> textureCache_;
+		struct CacheEntry {
+			// data is null once the pixels are evicted and id is 0 until buffered or once evicted
+			TextureData Texture;
+
+			unsigned int CpuRefs = 0, GpuRefs = 0;
+			size_t CpuBytes = 0, GpuBytes = 0;
+
+			std::list<StringId>::iterator LruPosition;
+		};
+
+		// all guarded by cacheMutex_
+		// keyed by the interned paths
+		static FlatHashMap<StringId, CacheEntry, StringIdHash> textureCache_;
+		static std::list<StringId> lru_;
+		static TextureCacheStats cacheStats_;
+		static size_t cpuBudget_, gpuBudget_;
+		static std::mutex cacheMutex_;
+
+		static void touchEntry(CacheEntry& entry);
+
+		// these expect cacheMutex_ to be locked, the evicted textures are returned to be deleted after unlocking
+		static void evictPixels();
+		static void evictTextures(std::vector<GLuint>& texturesToDelete);
+		static void removeEntryIfEmpty(const StringId& pathId);
+
+		static void uploadTexture(TextureData& texture);
 	};
-}
+}
\ No newline at end of file
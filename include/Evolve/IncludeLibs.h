@@ -37,6 +37,14 @@ SOFTWARE.
 #include <string>
 #include <vector>
 #include <map>
+#include <list>
 #include <unordered_map>
 #include <functional>
-#include <algorithm>
\ No newline at end of file
+#include <algorithm>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
\ No newline at end of file
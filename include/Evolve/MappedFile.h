@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// how the mapped pages will be read, a hint for the os' read ahead
+	enum class MappedFileAccess {
+		// read front to back once, like a baked atlas uploaded at load time
+		SEQUENTIAL,
+
+		// read in scattered places over a long time, like font tables or the mip levels of a streamed texture
+		RANDOM,
+
+		NORMAL
+	};
+
+	// a read only view of a whole file mapped into memory, the os pages it in on first access
+	class MappedFile {
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool openFile(const std::string& filePath, const MappedFileAccess access = MappedFileAccess::SEQUENTIAL);
+
+		const unsigned char* getData() const { return data_; }
+		size_t getSize() const { return size_; }
+
+		bool isOpen() const { return data_ != nullptr; }
+
+		void closeFile();
+
+	private:
+		const unsigned char* data_ = nullptr;
+		size_t size_ = 0;
+
+#ifdef _WIN32
+		void* fileHandle_ = nullptr;
+		void* mappingHandle_ = nullptr;
+#else
+		int fileDescriptor_ = -1;
+#endif
+	};
+}
\ No newline at end of file
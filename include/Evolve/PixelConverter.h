@@ -0,0 +1,49 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// cpu kernels for converting rgba8 pixels at load time,
+	// they use avx2, sse2 or neon when the build targets them and plain loops otherwise
+	class PixelConverter {
+	public:
+		// multiplies the color channels by alpha, rounded to the nearest value
+		static void PremultiplyAlpha(unsigned char* rgbaPixels, const size_t numPixels);
+
+		// keeps the top 5, 6 and 5 bits of red, green and blue, alpha is dropped
+		static void PackRgb565(const unsigned char* rgbaPixels, uint16_t* packedPixels, const size_t numPixels);
+
+		// keeps the top 4 bits of every channel
+		static void PackRgba4444(const unsigned char* rgbaPixels, uint16_t* packedPixels, const size_t numPixels);
+
+		// channel i of every pixel gets the old channel order[i], {2, 1, 0, 3} turns bgra into rgba
+		static void SwizzleChannels(unsigned char* rgbaPixels, const size_t numPixels, const unsigned char order[4]);
+
+		// the instruction set the kernels were built for
+		static const char* GetSimdName();
+	};
+}
\ No newline at end of file
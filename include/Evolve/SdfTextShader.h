@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "GlslProgram.h"
+#include "ColorRgba.h"
+#include "FontFaceCache.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// the shader for text of distance field fonts, with an optional outline and drop shadow drawn in the same pass
+	// pass getProgram() to TextureRenderer::renderTextures of a renderer in SINGLE_TEXTURE batching mode
+	// widths and offsets are in pixels of the font's base size, so they scale with the text,
+	// together they should stay within FontFaceCache::SDF_SPREAD, the distance fields end there
+	class SdfTextShader {
+	public:
+		SdfTextShader();
+		~SdfTextShader();
+
+		bool init(const std::string& pathToAssets);
+
+		// a width of 0 removes the outline
+		void setOutline(const ColorRgba& color, const float width);
+
+		// positive offsets move the shadow right and down, a transparent color removes the shadow
+		void setShadow(const ColorRgba& color, const float offsetX, const float offsetY, const float softness = 0.0f);
+
+		void clearStyle();
+
+		// sends the style to the program if it changed since the last call
+		GlslProgram* getProgram();
+
+		void freeSdfTextShader();
+
+	private:
+		GlslProgram program_;
+		bool inited_ = false;
+		bool styleChanged_ = true;
+
+		ColorRgba outlineColor_ { 0, 0, 0, 255 };
+		float outlineWidth_ = 0.0f;
+
+		ColorRgba shadowColor_ { 0, 0, 0, 0 };
+		float shadowOffsetX_ = 0.0f, shadowOffsetY_ = 0.0f;
+		float shadowSoftness_ = 0.0f;
+
+		void sendStyle();
+	};
+}
\ No newline at end of file
@@ -20,8 +20,6 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-/* DISCLAIMER: This class is heavily inefficient. Use TextureRenderer instead. */
-
 #pragma once
 
 #include "IncludeLibs.h"
@@ -30,6 +28,8 @@ SOFTWARE.
 #include "Vertex2D.h"
 #include "Camera.h"
 #include "RectDimension.h"
+#include "RadixSort.h"
+#include "RenderStats.h"
 
 namespace Evolve {
 
@@ -69,67 +69,160 @@ namespace Evolve {
 		void drawRectangle(const RectDimension& destRect,
 			const ColorRgba& verticesColor, int depth = 0);
 
-		// this is very inefficient, it's better to use a circular texture using TextureRenderer
+		// tessellated into a triangle fan, drawSmoothCircle is cheaper and anti-aliased,
+		// the number of segments follows the radius and the tessellation tolerance
 		void drawCircle(const Position2D& centerPos, unsigned int radius, const ColorRgba& color, int depth = 0);
 
+		// joins are mitered, sharp ones whose miter would get too long are beveled
+		void drawPolyline(const Position2D* points, size_t numPoints, float thickness,
+			const ColorRgba& color, int depth = 0);
+
+		void drawPolyline(const std::vector<Position2D>& points, float thickness,
+			const ColorRgba& color, int depth = 0);
+
+		// the points must form a convex polygon, in either winding order
+		void drawConvexPolygon(const Position2D* points, size_t numPoints, const ColorRgba& color, int depth = 0);
+
+		void drawConvexPolygon(const std::vector<Position2D>& points, const ColorRgba& color, int depth = 0);
+
+		// triangulated by ear clipping, the points must form a simple polygon without holes, in either winding order
+		void drawPolygon(const Position2D* points, size_t numPoints, const ColorRgba& color, int depth = 0);
+
+		void drawPolygon(const std::vector<Position2D>& points, const ColorRgba& color, int depth = 0);
+
+		// the largest distance in pixels between a tessellated circle's edge and the true circle,
+		// pixelsPerUnit converts world units to pixels if the shapes are drawn scaled
+		void setTessellationTolerance(float maxErrorPixels, float pixelsPerUnit = 1.0f);
+
+		// the following shapes are drawn as a single anti-aliased quad each, shaded by a signed distance function
+
+		void drawSmoothCircle(const Position2D& centerPos, float radius, const ColorRgba& color, int depth = 0);
+
+		// the ring lies inside the radius, from (radius - thickness) to radius
+		void drawRing(const Position2D& centerPos, float radius, float thickness, 
+			const ColorRgba& color, int depth = 0);
+
+		// the corner radius is clamped to half of the smaller side
+		void drawRoundedRectangle(const RectDimension& destRect, float cornerRadius, 
+			const ColorRgba& color, int depth = 0);
+
+		void drawLine(const Position2D& startPos, const Position2D& endPos, float thickness,
+			const ColorRgba& color, int depth = 0, bool roundCaps = false);
+
 		void end(const ShapeSortType& sortType = ShapeSortType::BY_DEPTH_INCREMENTAL);
 
+		// the passed shader replaces the default one for the tessellated shapes only, 
+		// the smooth shapes are always drawn with the sdf shader
 		void renderShapes(Camera& camera, GlslProgram* shader = nullptr);
 
 		void freeShapeRenderer();
 
-	private:
-		class Shape {
-		public:
-			friend class ShapeRenderer;
-			friend class ShapeBatch;
+		// stats of the last end() and renderShapes() calls
+		const RenderStats& getStats() const { return stats_; }
 
-			Shape(int depth, std::vector<Vertex2D> vertices, 
-				const unsigned int numVertices, const unsigned int numIndices);
+	private:
+		// vertex of a smooth shape's quad
+		struct SdfVertex2D {
+			GLfloat X, Y;
+			ColorRgba Color;
 
-			~Shape();
+			// position relative to the center of the shape, along the shape's own axes
+			GLfloat LocalX, LocalY;
 
-		private:
-			int depth_ = 0;
+			// an outline thickness of 0 fills the shape
+			GLfloat HalfWidth, HalfHeight, CornerRadius, OutlineThickness;
+		};
 
-			std::vector<Vertex2D> vertices_;
+		// a shape is a range of the frame's vertex and index arenas, its indices are relative to its first vertex,
+		// smooth shapes index into the sdf vertex arena
+		struct Shape {
+			int Depth;
+			bool IsSdf;
+			unsigned int VertexOffset, NumVertices;
+			unsigned int IndexOffset, NumIndices;
+		};
 
-			unsigned int numVertices_ = 0, numIndices_ = 0;
+		// unit circle points and fan indices for a segment count, the center is vertex 0
+		struct CircleTable {
+			std::vector<GLfloat> Points;
+			std::vector<GLuint> FanIndices;
 		};
 
 		class ShapeBatch {
 		public:
 			friend class ShapeRenderer;
 			
-			ShapeBatch(unsigned int offset, unsigned int numIndices);
+			ShapeBatch(unsigned int offset, unsigned int numIndices, bool isSdf);
 
 		private:
 			unsigned int offset_;
 			unsigned int numIndices_;
-			GLuint iboID_ = 0;
+			bool isSdf_;
 		};
 
 		GlslProgram defaultShader_;
+		GlslProgram sdfShader_;
 		GlslProgram* currentShader_ = nullptr;
 
 		bool inited_ = false;
 
-		GLuint vaoID_ = 0, vboID_ = 0;
-		std::vector<GLuint> iboIDs_;
+		RenderStats stats_;
 
-		GLuint totalVertices_ = 0, totalIndices_ = 0;
+		// both vaos share the ibo, the indices of each stream are relative to its own vbo
+		GLuint vaoID_ = 0, vboID_ = 0, iboID_ = 0;
+		GLuint sdfVaoID_ = 0, sdfVboID_ = 0;
 
-		//std::vector<Triangle> m_triangles;
+		// capacities of the vbos and ibo in bytes, these only grow
+		GLsizeiptr vboCapacity_ = 0, iboCapacity_ = 0, sdfVboCapacity_ = 0;
+
+		// the arenas are cleared every frame but keep their capacity, 
+		// so adding shapes doesn't allocate once they've grown to the frame's needs
+		std::vector<Vertex2D> vertexArena_;
+		std::vector<SdfVertex2D> sdfVertexArena_;
+		std::vector<GLuint> indexArena_;
 		std::vector<Shape> shapes_;
-		std::vector<Shape*> shapePointers_;
+
+		// (depth key, shape index) pairs, in drawing order after sorting
+		std::vector<SortEntry> sortEntries_, sortScratch_;
+
+		// the sorted vertices and indices to upload
+		std::vector<Vertex2D> vertices_;
+		std::vector<SdfVertex2D> sdfVertices_;
+		std::vector<GLuint> vertexIndices_;
+
 		std::vector<ShapeBatch> shapeBatches_;
 
+		float tessellationTolerance_ = 0.25f;
+		float pixelsPerUnit_ = 1.0f;
+
+		// the polygon vertices not clipped yet while triangulating
+		std::vector<GLuint> polygonScratch_;
+
+		// keyed by segment count, which is rounded so only a few tables are ever built
+		std::unordered_map<unsigned int, CircleTable> circleTables_;
+
+		unsigned int getCircleSegments(float radius) const;
+		const CircleTable& getCircleTable(unsigned int numSegments);
+
 		void createVao();
 		void setupShapeBatches();
-		void addIndicesToBuffer(std::vector<GLuint>& indices, const int numIndices, 
-			unsigned int& currentIndex, unsigned int& currentVertex);
+		void uploadBufferData(GLenum target, GLuint bufferID, GLsizeiptr& capacity,
+			GLsizeiptr size, const void* data);
+
+		// adds a shape and returns where to write its vertices, valid until the next shape is added
+		Vertex2D* addShape(int depth, unsigned int numVertices, const GLuint* indices, unsigned int numIndices);
+
+		// like addShape, but the caller writes the indices too
+		Vertex2D* reserveShape(int depth, unsigned int numVertices, unsigned int numIndices, GLuint*& indices);
+
+		// shrinks the last added shape, for shapes reserved with an upper bound of their size
+		void trimLastShape(unsigned int numVertices, unsigned int numIndices);
+
+		// adds a smooth shape's quad centered at (centerX, centerY), 
+		// its local x axis points along (axisX, axisY) which must be normalized
+		void addSdfQuad(int depth, float centerX, float centerY, float axisX, float axisY,
+			float halfWidth, float halfHeight, float cornerRadius, float outlineThickness, const ColorRgba& color);
 
-		static bool compareByDepthIncremental(Shape* a, Shape* b);
-		static bool compareByDepthDecremental(Shape* a, Shape* b);
+		void sortShapes(const ShapeSortType& sortType);
 	};
 }
\ No newline at end of file
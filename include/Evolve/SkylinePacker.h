@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+namespace Evolve {
+
+	// packs rects into a fixed size area by placing each one as low as possible on a skyline,
+	// it only tracks the used space, the owner stores the pixels
+	class SkylinePacker {
+	public:
+		// a horizontal segment of the skyline, the rows above Y are used from X to X + Width
+		struct Node {
+			int X, Y, Width;
+		};
+
+		SkylinePacker() {};
+		~SkylinePacker() {};
+
+		void init(const int width, const int height);
+
+		// claims room for the rect and returns its top left, returns false if it doesn't fit
+		bool insert(const int width, const int height, int& x, int& y);
+
+		const std::vector<Node>& getNodes() const { return nodes_; }
+
+		// restores a skyline saved from getNodes
+		void setNodes(const std::vector<Node>& nodes) { nodes_ = nodes; }
+
+	private:
+		int width_ = 0, height_ = 0;
+
+		std::vector<Node> nodes_;
+
+		bool findPosition(const int width, const int height, int& x, int& y) const;
+		void addNode(const int x, const int y, const int width, const int height);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "ColorRgba.h"
+#include "UvDimension.h"
+#include "RectDimension.h"
+
+namespace Evolve {
+
+	// a textured quad as one compact record, sent as is to the gpu when drawing instanced
+	struct SpriteInstance {
+		GLint Left, Bottom, Right, Top;
+		UvDimension Uv;
+		ColorRgba Color;
+
+		// the texture unit to sample from when multiple textures are bound in a batch
+		GLuint TextureSlot;
+
+		void set(const RectDimension& destRect, const UvDimension& uvRect, const ColorRgba& color) {
+			Left = destRect.getLeft();
+			Bottom = destRect.getBottom();
+			Right = destRect.getRight();
+			Top = destRect.getTop();
+
+			Uv = uvRect;
+			Color = color;
+			TextureSlot = 0;
+		}
+	};
+}
\ No newline at end of file
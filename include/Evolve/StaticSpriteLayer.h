@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "TextureRenderer.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// sprites that rarely change, like tile maps and backgrounds
+	// they are sorted and uploaded into gpu buffers once and only rebuilt when the layer is changed,
+	// every other frame only the batches are drawn
+	class StaticSpriteLayer {
+	public:
+		StaticSpriteLayer();
+		~StaticSpriteLayer();
+
+		bool init(const std::string& pathToAssets,
+			const TextureBatchingMode batchingMode = TextureBatchingMode::MULTI_TEXTURE,
+			const GlyphSortType& sortType = GlyphSortType::BY_DEPTH_AND_TEXTURE_ID_INCREMENTAL);
+
+		// returns the id of the sprite
+		size_t addSprite(const RectDimension& destRect, const UvDimension& uvRect,
+			GLuint textureID, const ColorRgba& color, int depth = 0);
+
+		void setSprite(const size_t id, const RectDimension& destRect, const UvDimension& uvRect,
+			GLuint textureID, const ColorRgba& color, int depth = 0);
+
+		void showSprite(const size_t id);
+		void hideSprite(const size_t id);
+
+		// removes all the sprites, the ids of the removed sprites become invalid
+		void clear();
+
+		// rebuilds the gpu buffers first if the layer was changed since the last render
+		// the default shader will be used if no shader passed
+		void renderLayer(Camera& camera, GlslProgram* shader = nullptr);
+
+		size_t getNumSprites() const { return sprites_.size(); }
+		bool isChanged() const { return changed_; }
+
+		const RenderStats& getStats() const { return textureRenderer_.getStats(); }
+
+		void freeStaticSpriteLayer();
+
+	private:
+		struct Sprite {
+			RectDimension DestRect;
+			UvDimension UvRect;
+			GLuint TextureID;
+			ColorRgba Color;
+			int Depth;
+			bool IsVisible;
+		};
+
+		TextureRenderer textureRenderer_;
+		GlyphSortType sortType_ = GlyphSortType::BY_DEPTH_AND_TEXTURE_ID_INCREMENTAL;
+
+		bool inited_ = false;
+		bool changed_ = true;
+
+		std::vector<Sprite> sprites_;
+
+		void rebuild();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "BakedAtlas.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// a large texture whose mip levels are streamed in from a baked texture file as they're needed
+	// the coarse levels up to the tail size are uploaded at init, the finer ones are uploaded by update
+	// in chunks of rows once the texture covers enough of the screen, and released when it shrinks again
+	// only the resident levels take video memory, GL_TEXTURE_BASE_LEVEL points to the finest complete one
+	class StreamingTexture {
+	public:
+		StreamingTexture();
+		~StreamingTexture();
+
+		// the file is baked by the atlas baker with --texture,
+		// levels no larger than tailSize on both sides are always resident
+		bool init(const std::string& bakedFilePath, const unsigned int tailSize = 256);
+
+		// the size in pixels the texture is drawn at, picks the finest level update streams towards
+		void setScreenSize(const float width, const float height);
+
+		// uploads at most budgetBytes of pixels, call once per frame on the gl thread
+		void update(const size_t budgetBytes = 4 * 1024 * 1024);
+
+		GLuint getTextureID() const { return textureID_; }
+
+		int getWidth() const { return width_; }
+		int getHeight() const { return height_; }
+
+		unsigned int getResidentLevel() const { return residentLevel_; }
+		unsigned int getTargetLevel() const { return targetLevel_; }
+		size_t getResidentBytes() const { return residentBytes_; }
+
+		void freeStreamingTexture();
+
+	private:
+		MappedFile file_;
+
+		GLuint textureID_ = 0;
+		int width_ = 0, height_ = 0;
+		unsigned int colorChannels_ = 0;
+
+		const BakedAtlasLevel* levels_ = nullptr;
+		unsigned int numLevels_ = 0;
+
+		// the finest level that is always resident
+		unsigned int tailLevel_ = 0;
+
+		// the finest complete level and the level update streams towards
+		unsigned int residentLevel_ = 0;
+		unsigned int targetLevel_ = 0;
+
+		// the level being uploaded, one finer than the resident level, and how many of its rows are done
+		bool uploading_ = false;
+		unsigned int uploadedRows_ = 0;
+
+		size_t residentBytes_ = 0;
+
+		bool inited_ = false;
+
+		GLenum getPixelFormat() const { return colorChannels_ == 1 ? GL_RED : GL_RGBA; }
+		GLint getInternalFormat() const { return colorChannels_ == 1 ? GL_RED : GL_RGBA8; }
+
+		void uploadLevel(const unsigned int level);
+		void releaseLevel(const unsigned int level);
+		void setBaseLevel(const unsigned int level);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "FlatHashMap.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// 64 bit fnv-1a, usable at compile time
+	constexpr uint64_t hashString(const char* str) {
+		uint64_t hash = 14695981039346656037ull;
+
+		for (; *str != '\0'; str++) {
+			hash ^= (uint64_t) (unsigned char) *str;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	// a string identified by its hash, comparing and hashing ids never touches the characters
+	// ids of string literals can be made at compile time,
+	// any other string should be interned so the id can still give back its string
+	class StringId {
+	public:
+		constexpr StringId() {}
+
+		// the string must outlive the id, like a string literal does
+		explicit constexpr StringId(const char* str) : hash_(hashString(str)), string_(str) {}
+
+		// copies the string into the intern table once, safe to call from any thread
+		static StringId intern(const std::string& str);
+
+		constexpr uint64_t getHash() const { return hash_; }
+
+		// empty for the default id
+		const char* getString() const { return string_; }
+
+		constexpr bool operator==(const StringId& other) const { return hash_ == other.hash_; }
+		constexpr bool operator!=(const StringId& other) const { return hash_ != other.hash_; }
+		constexpr bool operator<(const StringId& other) const { return hash_ < other.hash_; }
+
+	private:
+		uint64_t hash_ = 0;
+		const char* string_ = "";
+	};
+
+	struct StringIdHash {
+		size_t operator()(const StringId& id) const { return (size_t) id.getHash(); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "SpriteInstance.h"
+#include "ColorRgba.h"
+#include "TextureRenderer.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	class Font;
+
+	enum class TextAlignment {
+		LEFT,
+		CENTER,
+		RIGHT,
+
+		// wrapped lines are stretched to the max width by widening their spaces,
+		// the last line of a paragraph is left aligned
+		JUSTIFY
+	};
+
+	struct TextLayoutOptions {
+		// lines are wrapped at spaces to fit, or inside a word too long for a line, 0 doesn't wrap
+		int MaxWidth = 0;
+
+		// lines are aligned in the max width, or in the widest line when not wrapping
+		TextAlignment Alignment = TextAlignment::LEFT;
+
+		bool Kerning = true;
+	};
+
+	struct TextLine {
+		// the bytes of the line in the text, without the newline or the space it was wrapped at
+		size_t Begin = 0, End = 0;
+
+		// from the left and the top of the text, after aligning
+		int Left = 0, Top = 0;
+
+		int Width = 0;
+	};
+
+	// the glyph quads of a text laid out once and drawn for many frames,
+	// it's only laid out again when the text, the options, the font or the font's settings change
+	// laying out is one pass over the text, wrapping moves back only the quads of the word being wrapped
+	class TextLayout {
+	public:
+		TextLayout();
+		~TextLayout();
+
+		// the font must outlive the layout, returns true if the text had to be laid out
+		bool update(const Font& font, const char* text, const TextLayoutOptions& options = TextLayoutOptions());
+
+		// copies the quads into the renderer in one go per texture
+		void draw(TextureRenderer& textureRenderer, const int topLeftX, const int topLeftY, 
+			const ColorRgba& color, const int depth = 0);
+
+		// the size of the text's bounds, the height is as getTextHeight of the font
+		int getWidth() const { return width_; }
+		int getHeight() const { return height_; }
+
+		const std::vector<TextLine>& getLines() const { return lines_; }
+
+		size_t getNumGlyphs() const { return quads_.size(); }
+
+		void clear();
+
+	private:
+		// the quads of the text that use one texture
+		struct GlyphRun {
+			GLuint TextureID;
+			size_t First, Count;
+		};
+
+		// what the quads of a line need for aligning them
+		struct LineQuads {
+			size_t First = 0, Count = 0;
+
+			// the spaces between the words of the line, which justifying widens
+			int NumGaps = 0;
+			bool EndsParagraph = false;
+		};
+
+		// what the text was laid out with
+		const Font* font_ = nullptr;
+		unsigned int fontGeneration_ = 0;
+		float fontScale_ = 0.0f;
+		TextLayoutOptions options_;
+		std::string text_;
+
+		// relative to the top left of the text, grouped by texture
+		std::vector<SpriteInstance> quads_;
+		std::vector<GlyphRun> runs_;
+		std::vector<TextLine> lines_;
+
+		// the color written in the quads
+		ColorRgba color_ { 255, 255, 255, 255 };
+
+		int width_ = 0, height_ = 0;
+
+		// kept in text order while laying out, the texture of each quad 
+		// and the number of spaces before it in its line
+		std::vector<GLuint> quadTextureIDs_;
+		std::vector<int> quadGaps_;
+		std::vector<LineQuads> lineQuads_;
+		std::vector<SpriteInstance> sortScratch_;
+
+		void layoutText(const Font& font, const char* text);
+		void alignLines();
+		void groupQuadsByTexture();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "ImageLoader.h"
+#include "UvDimension.h"
+#include "SkylinePacker.h"
+#include "ErrorReporter.h"
+
+namespace Evolve {
+
+	// where an image lives in the atlas, the texture ID and uv plug directly into TextureRenderer::draw
+	struct AtlasRegion {
+		GLuint TextureID = 0;
+		UvDimension Uv {};
+		unsigned int Page = 0;
+
+		// position of the image in the page in pixels, from the top left
+		int X = 0, Y = 0;
+		int Width = 0, Height = 0;
+	};
+
+	// packs many images into a few large textures so they can be drawn in the same batch
+	// images can be added at any time, each is uploaded into a page with glTexSubImage2D,
+	// a packed atlas can also be saved to a file and loaded back instead of packing it at runtime
+	class TextureAtlas {
+	public:
+		TextureAtlas();
+		~TextureAtlas();
+
+		// color channels must be 1 or 4, the padding around each image is filled with its edge pixels
+		// without keepPixels the pages live only on the GPU, the atlas then can't be saved
+		bool init(const int pageWidth, const int pageHeight, const unsigned int colorChannels = 4, 
+			const int padding = 1, const bool keepPixels = true);
+
+		// adding a name that is already in the atlas returns the existing region
+		bool addImage(const std::string& name, const std::string& imagePath, AtlasRegion& region);
+
+		// the pixels must have the atlas's number of color channels, rows from the top
+		bool addPixels(const std::string& name, const unsigned char* pixels, const int width, const int height,
+			AtlasRegion& region);
+
+		// packs the pixels without storing a region, for callers that keep the region themselves
+		bool addPixels(const unsigned char* pixels, const int width, const int height, AtlasRegion& region);
+
+		// returns false if there's no image with the name
+		bool getRegion(const std::string& name, AtlasRegion& region) const;
+
+		size_t getNumPages() const { return pages_.size(); }
+		GLuint getPageTextureID(const unsigned int page) const;
+
+		bool saveToFile(const std::string& filePath) const;
+
+		// replaces the contents of the atlas, the atlas doesn't need to be initialized
+		bool loadFromFile(const std::string& filePath);
+
+		void freeTextureAtlas();
+
+	private:
+		struct Page {
+			GLuint TextureID = 0;
+
+			// kept to save the page, empty if the atlas doesn't keep its pixels
+			std::vector<unsigned char> Pixels;
+			SkylinePacker Packer;
+		};
+
+		int pageWidth_ = 0, pageHeight_ = 0;
+		unsigned int colorChannels_ = 0;
+		int padding_ = 0;
+		bool keepPixels_ = true;
+
+		bool inited_ = false;
+
+		std::vector<Page> pages_;
+		std::unordered_map<std::string, AtlasRegion> regions_;
+
+		// the padded image is built here when there's no page copy to build it in
+		std::vector<unsigned char> uploadPixels_;
+
+		bool packPixels(const unsigned char* pixels, const int width, const int height, AtlasRegion& region);
+
+		void addPage();
+		void createPageTexture(Page& page);
+
+		void setRegionUv(AtlasRegion& region) const;
+	};
+}
\ No newline at end of file
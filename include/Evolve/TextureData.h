@@ -26,11 +26,22 @@ SOFTWARE.
 
 namespace Evolve {
 
+	// how the pixels are laid out in memory, BYTE_PER_CHANNEL has bitsPerPixel channels of one byte each,
+	// the packed formats take two bytes per pixel with the red bits in the most significant ones
+	enum class TexturePixelFormat {
+		BYTE_PER_CHANNEL,
+		RGB565,
+		RGBA4444
+	};
+
 	struct TextureData {
 		std::string path = "";
 		GLuint id = 0;
 		unsigned char* data = nullptr;
 		int width = 0, height = 0;
 		int bitsPerPixel = 0, bitsPerPixelInFile = 0;
+
+		TexturePixelFormat format = TexturePixelFormat::BYTE_PER_CHANNEL;
+		bool premultipliedAlpha = false;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+#include "TextureData.h"
+#include "StringId.h"
+
+namespace Evolve {
+
+	enum class TextureLoadStatus {
+		LOADING,
+		DECODED,
+		READY,
+		FAILED
+	};
+
+	// the result of an asynchronous texture load, copies share the same load
+	// the texture becomes ready once its pixels are decoded and uploaded by AsyncImageLoader::processUploads
+	class TextureHandle {
+	public:
+		friend class AsyncImageLoader;
+
+		TextureHandle() {};
+		~TextureHandle() {};
+
+		bool isValid() const { return state_ != nullptr; }
+
+		TextureLoadStatus getStatus() const { 
+			return state_ != nullptr ? state_->Status.load(std::memory_order_acquire) : TextureLoadStatus::FAILED; 
+		}
+
+		bool isReady() const { return getStatus() == TextureLoadStatus::READY; }
+		bool hasFailed() const { return getStatus() == TextureLoadStatus::FAILED; }
+
+		// 0 until the texture is ready
+		GLuint getTextureID() const { return isReady() ? state_->Texture.id : 0; }
+
+		// only complete once the texture is ready, its pixel data is released after uploading
+		const TextureData& getTexture() const { return state_->Texture; }
+
+	private:
+		struct State {
+			std::atomic<TextureLoadStatus> Status { TextureLoadStatus::LOADING };
+			TextureData Texture;
+			unsigned int ColorChannels = 4;
+
+			// the key of the request in the loader, a failed load clears the texture's path
+			StringId PathId;
+		};
+
+		std::shared_ptr<State> state_;
+	};
+}
\ No newline at end of file
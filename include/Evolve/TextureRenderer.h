@@ -29,14 +29,56 @@ SOFTWARE.
 #include "RectDimension.h"
 #include "UvDimension.h"
 #include "Vertex2D.h"
+#include "SpriteInstance.h"
+#include "RenderStats.h"
+#include "RadixSort.h"
 
 namespace Evolve {
 
 	enum class GlyphSortType {
 		BY_TEXTURE_ID_INCREMENTAL,
 		BY_TEXTURE_ID_DECREMENTAL,
-		/*BY_DEPTH_INCREMENTAL,
-		BY_DEPTH_DECREMENTAL*/
+		BY_DEPTH_INCREMENTAL,
+		BY_DEPTH_DECREMENTAL,
+
+		// sorted by depth first, glyphs of the same depth are sorted by texture id
+		BY_DEPTH_AND_TEXTURE_ID_INCREMENTAL,
+		BY_DEPTH_AND_TEXTURE_ID_DECREMENTAL
+	};
+
+	enum class TextureBatchingMode {
+		// a new batch and draw call is started whenever the texture changes
+		SINGLE_TEXTURE,
+
+		// up to MAX_TEXTURE_SLOTS textures are bound per draw call, uses the multi texture shader
+		// a custom shader for this mode has to sample from the u_imageSamplers array by the texture slot
+		MULTI_TEXTURE,
+
+		// batched like MULTI_TEXTURE, but every sprite is uploaded as one SpriteInstance record
+		// and expanded to a quad in the instanced texture shader instead of as four vertices
+		INSTANCED
+	};
+
+	enum class BufferUploadMode {
+		// the vertices are gathered into a vector and copied with glBufferSubData into an orphaned vbo
+		BUFFER_SUB_DATA,
+
+		// the vertices are written straight into a mapped region of a triple buffered vbo,
+		// fences make sure a region is not overwritten while the gpu may still read it
+		MAPPED_RING,
+
+		// for glyphs drawn once and rendered for many frames, like StaticSpriteLayer
+		// every end() respecifies the vbo with GL_STATIC_DRAW in exactly the size needed
+		STATIC
+	};
+
+	enum class TextureBlendMode {
+		// glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), the blending set up by the window
+		STRAIGHT_ALPHA,
+
+		// glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA), for textures with premultiplied alpha
+		// the rgb of the tint colors is multiplied by their alpha when drawn
+		PREMULTIPLIED_ALPHA
 	};
 
 	class TextureRenderer {
@@ -44,7 +86,9 @@ namespace Evolve {
 		TextureRenderer();
 		~TextureRenderer();
 
-		bool init(const std::string& pathToAssets);
+		bool init(const std::string& pathToAssets,
+			const TextureBatchingMode batchingMode = TextureBatchingMode::SINGLE_TEXTURE,
+			const BufferUploadMode uploadMode = BufferUploadMode::MAPPED_RING);
 
 		// the default shader will be used if no shader passed
 		void begin();
@@ -52,39 +96,41 @@ namespace Evolve {
 		void draw(const RectDimension& destRect, const UvDimension& uvRect,
 			GLuint textureID, const ColorRgba& color, int depth = 0);
 
+		// draws sprites prepared ahead, like a TextLayout, that all use one texture
+		// they're copied in one go and moved by the offset
+		void draw(const SpriteInstance* sprites, const size_t numSprites, GLuint textureID,
+			const int offsetX = 0, const int offsetY = 0, int depth = 0);
+
 		void end(const GlyphSortType& sortType = GlyphSortType::BY_TEXTURE_ID_INCREMENTAL);
 
 		void renderTextures(Camera& camera, GlslProgram* shader = nullptr);
 
 		void freeTextureRenderer();
 
-	private:
-		class Glyph {
-		public:
-			friend class TextureRenderer;
-			friend class RenderBatch;
+		// applies to the glyphs drawn after it, every renderTextures() call should render glyphs of one mode
+		void setBlendMode(const TextureBlendMode blendMode) { blendMode_ = blendMode; }
+		TextureBlendMode getBlendMode() const { return blendMode_; }
 
-			Glyph(const RectDimension& destRect, const UvDimension& uvRect,
-				GLuint textureID, const ColorRgba& color, int depth);
-
-		private:
-			GLuint textureID_ = 0;
-			int depth_ = 0;
+		// stats of the last end() and renderTextures() calls
+		const RenderStats& getStats() const { return stats_; }
 
-			Vertex2D vertices_[4] = {};
-		};
+		static const unsigned int MAX_TEXTURE_SLOTS = 16;
 
+	private:
 		class RenderBatch {
 		public:
 			friend class TextureRenderer;
-			RenderBatch(unsigned int offset, unsigned int numIndices, GLuint textureID);
+			RenderBatch(unsigned int firstGlyph, unsigned int textureOffset);
 
 		private:
 
-			unsigned int offset_;
-			unsigned int numIndices_;
-			GLuint textureID_;
-			GLuint iboID_ = 0;
+			// the range of sorted glyphs drawn by this batch
+			unsigned int firstGlyph_;
+			unsigned int numGlyphs_ = 0;
+
+			// the textures of this batch are in batchTextureIDs_, in the order of their slots
+			unsigned int textureOffset_;
+			unsigned int numTextures_ = 0;
 		};
 
 		GlslProgram defaultShader_;
@@ -92,20 +138,69 @@ namespace Evolve {
 
 		bool inited_ = false;
 
+		TextureBatchingMode batchingMode_ = TextureBatchingMode::SINGLE_TEXTURE;
+		unsigned int maxTextureSlots_ = 1;
+
+		RenderStats stats_;
+
+		TextureBlendMode blendMode_ = TextureBlendMode::STRAIGHT_ALPHA;
+
 		GLuint vaoID_ = 0, vboID_ = 0;
-		std::vector<GLuint> iboIDs_;
 
-		std::vector<Glyph> glyphs_;
-		std::vector<Glyph*> glyphPointers_;
+		// capacity of the vbo in bytes, only grows
+		GLsizeiptr vboCapacity_ = 0;
+
+		BufferUploadMode uploadMode_ = BufferUploadMode::MAPPED_RING;
+
+		static const unsigned int NUM_RING_REGIONS = 3;
+
+		// the vbo holds vertices, or SpriteInstance records when drawing instanced
+		// with the mapped ring the vbo is split in NUM_RING_REGIONS equal regions, one written per frame
+		unsigned int currentRegion_ = 0;
+		GLsync regionFences_[NUM_RING_REGIONS] = {};
+		bool uploadMapped_ = false;
+
+		// where the vertex data of the current frame starts in the vbo
+		GLintptr uploadOffset_ = 0;
+
+		// vertex data is gathered here when not written to a mapped buffer
+		std::vector<unsigned char> uploadScratch_;
+
+		// every glyph is a quad, so all the renderers draw from one static ibo 
+		// holding the 0, 1, 2, 0, 3, 2 pattern for as many quads as ever needed
+		static GLuint quadIboID_;
+		static unsigned int quadIboCapacity_;
+		static unsigned int quadIboUsers_;
+
+		// what the glyphs are sorted and batched by, kept apart from the glyphs
+		// so building the sort keys reads a compact array instead of striding over whole glyphs
+		struct GlyphSortData {
+			GLuint TextureID;
+			int Depth;
+		};
+
+		std::vector<SpriteInstance> glyphs_;
+		std::vector<GlyphSortData> glyphSortData_;
+
+		// (sort key, glyph index) pairs, in drawing order after sorting
+		std::vector<SortEntry> sortEntries_, sortScratch_;
 		std::vector<RenderBatch> renderBatches_;
+		std::vector<GLuint> batchTextureIDs_;
 
 		void createVao();
 		void setupRenderBatches();
-		void addIndicesToBuffer(std::vector<GLuint>& indices, unsigned int& currentIndex, unsigned int& currentVertex);
+		static void writeQuadVertices(const SpriteInstance& glyph, Vertex2D* destination);
+		void setVertexAttribPointers(GLintptr offset);
+
+		// returns where to write size bytes of vertex data for this frame, endUpload() must follow
+		void* beginUpload(GLsizeiptr size);
+		void endUpload(GLsizeiptr size);
+
+		void uploadVertexData(const void* data, GLsizeiptr size);
+		void waitForRegion(unsigned int region);
+		void deleteRegionFences();
+		void reserveQuadIndices(unsigned int numQuads);
 
-		static bool compareByTextureIdIncremental(Glyph* a, Glyph* b);
-		static bool compareByTextureIdDecremental(Glyph* a, Glyph* b);
-		/*static bool compareByDepthIncremental(Glyph* a, Glyph* b);
-		static bool compareByDepthDecremental(Glyph* a, Glyph* b);*/
+		void sortGlyphs(const GlyphSortType& sortType);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "IncludeLibs.h"
+
+namespace Evolve {
+
+	const uint32_t UTF8_REPLACEMENT_CHARACTER = 0xFFFD;
+
+	// returns the code point starting at text[index] and moves index past it,
+	// a malformed sequence decodes to the replacement character and skips one byte,
+	// the text must be null terminated, the terminator is never read past
+	inline uint32_t decodeUtf8(const char* text, size_t& index) {
+		const unsigned char* bytes = (const unsigned char*) text + index;
+		unsigned char lead = bytes[0];
+
+		if (lead < 0x80) {
+			index++;
+			return lead;
+		}
+
+		int length = 0;
+		uint32_t codePoint = 0;
+		uint32_t minCodePoint = 0;
+
+		if ((lead & 0xE0) == 0xC0) {
+			length = 2;
+			codePoint = lead & 0x1F;
+			minCodePoint = 0x80;
+		}
+		else if ((lead & 0xF0) == 0xE0) {
+			length = 3;
+			codePoint = lead & 0x0F;
+			minCodePoint = 0x800;
+		}
+		else if ((lead & 0xF8) == 0xF0) {
+			length = 4;
+			codePoint = lead & 0x07;
+			minCodePoint = 0x10000;
+		}
+		else {
+			index++;
+			return UTF8_REPLACEMENT_CHARACTER;
+		}
+
+		// a null terminator isn't a continuation byte, so this stops at the end of the text
+		for (int i = 1; i < length; i++) {
+			if ((bytes[i] & 0xC0) != 0x80) {
+				index++;
+				return UTF8_REPLACEMENT_CHARACTER;
+			}
+
+			codePoint = (codePoint << 6) | (bytes[i] & 0x3F);
+		}
+
+		// overlong encodings, surrogates and code points past the unicode range
+		if (codePoint < minCodePoint || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF) {
+			index++;
+			return UTF8_REPLACEMENT_CHARACTER;
+		}
+
+		index += length;
+		return codePoint;
+	}
+}
\ No newline at end of file
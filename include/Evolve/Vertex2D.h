@@ -35,6 +35,9 @@ namespace Evolve {
 		ColorRgba Color {};
 		TextureCoords2D TextureCoords {};
 
+		// the texture unit to sample from when multiple textures are bound in a batch
+		GLuint TextureSlot = 0;
+
 		void setPosition(const GLint x, const GLint y) {
 			Position.set(x, y);
 		}
@@ -62,5 +65,9 @@ namespace Evolve {
 		void setTextureCoords(const TextureCoords2D& newCoords) {
 			TextureCoords.set(newCoords);
 		}
+
+		void setTextureSlot(const GLuint slot) {
+			TextureSlot = slot;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/AsyncImageLoader.h"
+
+Evolve::AsyncImageLoader::AsyncImageLoader() {}
+
+Evolve::AsyncImageLoader::~AsyncImageLoader() {
+	freeAsyncImageLoader();
+}
+
+bool Evolve::AsyncImageLoader::init(unsigned int numThreads /*= 0*/) {
+	if (inited_) {
+		EVOLVE_REPORT_ERROR("Async image loader already initialized.", init);
+		return false;
+	}
+
+	if (numThreads == 0) {
+		unsigned int numCores = std::thread::hardware_concurrency();
+		numThreads = numCores > 1 ? numCores - 1 : 1;
+	}
+
+	stopping_ = false;
+
+	for (unsigned int i = 0; i < numThreads; i++) {
+		workers_.emplace_back(&AsyncImageLoader::workerLoop, this);
+	}
+
+	inited_ = true;
+	return true;
+}
+
+Evolve::TextureHandle Evolve::AsyncImageLoader::loadTexture(const std::string& imagePath, 
+	const unsigned int colorChannels) {
+
+	TextureHandle handle;
+
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Async image loader not initialized.", loadTexture);
+		return handle;
+	}
+
+	if (colorChannels != 1 && colorChannels != 4) {
+		std::string errStr = "Invalid Color channel " + std::to_string(colorChannels) + ".";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), loadTexture);
+		return handle;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(requestsMutex_);
+
+		const StatePtr* request = requests_.find(StringId(imagePath.c_str()));
+
+		if (request != nullptr) {
+			// the image cache keeps one copy of a path's pixels, so it can't be loaded in two formats
+			if ((*request)->ColorChannels != colorChannels) {
+				std::string errStr = imagePath + " is already requested with " + 
+					std::to_string((*request)->ColorChannels) + " color channels.";
+				EVOLVE_REPORT_ERROR(errStr.c_str(), loadTexture);
+				return handle;
+			}
+
+			handle.state_ = *request;
+			return handle;
+		}
+
+		handle.state_ = std::make_shared<TextureHandle::State>();
+		handle.state_->Texture.path = imagePath;
+		handle.state_->ColorChannels = colorChannels;
+		handle.state_->PathId = StringId::intern(imagePath);
+
+		requests_[handle.state_->PathId] = handle.state_;
+	}
+
+	numPending_.fetch_add(1, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex_);
+		jobs_.push_back(handle.state_);
+	}
+
+	jobsCondition_.notify_one();
+
+	return handle;
+}
+
+void Evolve::AsyncImageLoader::processUploads(const double budgetMilliseconds /*= 2.0*/) {
+	auto startTime = std::chrono::steady_clock::now();
+
+	while (true) {
+		StatePtr state;
+
+		{
+			std::lock_guard<std::mutex> lock(uploadsMutex_);
+
+			if (uploads_.empty()) {
+				break;
+			}
+
+			state = uploads_.front();
+			uploads_.pop_front();
+		}
+
+		ImageLoader::BufferTextureData(state->Texture);
+
+		// the handle only keeps a reference to the gl texture, the cached pixels can be evicted
+		ImageLoader::FreeTexture(state->Texture);
+
+		state->Status.store(state->Texture.id != 0 ? TextureLoadStatus::READY : TextureLoadStatus::FAILED, 
+			std::memory_order_release);
+
+		numPending_.fetch_sub(1, std::memory_order_relaxed);
+
+		// every handle may have been released while it was loading
+		releaseIfUnused(state);
+
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		if (elapsed.count() >= budgetMilliseconds) {
+			break;
+		}
+	}
+}
+
+void Evolve::AsyncImageLoader::releaseTexture(TextureHandle& handle) {
+	if (!handle.isValid()) {
+		return;
+	}
+
+	StatePtr state = std::move(handle.state_);
+	releaseIfUnused(state);
+}
+
+void Evolve::AsyncImageLoader::releaseIfUnused(StatePtr& state) {
+	{
+		std::lock_guard<std::mutex> lock(requestsMutex_);
+
+		const StatePtr* request = requests_.find(state->PathId);
+
+		// handles are only made under the lock, so none can appear while checking
+		if (request == nullptr || *request != state || state.use_count() > 2) {
+			return;
+		}
+
+		requests_.erase(state->PathId);
+	}
+
+	if (state->Texture.id != 0) {
+		ImageLoader::DeleteTexture(state->Texture);
+	}
+}
+
+void Evolve::AsyncImageLoader::freeAsyncImageLoader() {
+	if (!inited_) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex_);
+		stopping_ = true;
+	}
+
+	jobsCondition_.notify_all();
+
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+
+	workers_.clear();
+	jobs_.clear();
+	uploads_.clear();
+
+	requests_.forEach([](const StringId&, StatePtr& state) {
+		// decoded but never uploaded requests still hold a reference to the cached pixels
+		if (state->Texture.data != nullptr) {
+			ImageLoader::FreeTexture(state->Texture);
+		}
+
+		if (state->Texture.id != 0) {
+			ImageLoader::DeleteTexture(state->Texture);
+		}
+
+		state->Status.store(TextureLoadStatus::FAILED, std::memory_order_release);
+	});
+
+	requests_.clear();
+	numPending_.store(0, std::memory_order_relaxed);
+
+	inited_ = false;
+}
+
+void Evolve::AsyncImageLoader::workerLoop() {
+	while (true) {
+		StatePtr state;
+
+		{
+			std::unique_lock<std::mutex> lock(jobsMutex_);
+
+			jobsCondition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+
+			if (stopping_) {
+				return;
+			}
+
+			state = jobs_.front();
+			jobs_.pop_front();
+		}
+
+		// the path is copied as a failed load clears it
+		std::string imagePath = state->Texture.path;
+
+		ImageLoader::LoadTextureFromImage(imagePath, state->Texture, state->ColorChannels);
+
+		if (state->Texture.data == nullptr) {
+			// forgotten so the next request of the path tries again
+			{
+				std::lock_guard<std::mutex> lock(requestsMutex_);
+
+				const StatePtr* request = requests_.find(state->PathId);
+
+				if (request != nullptr && *request == state) {
+					requests_.erase(state->PathId);
+				}
+			}
+
+			state->Status.store(TextureLoadStatus::FAILED, std::memory_order_release);
+			numPending_.fetch_sub(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		state->Status.store(TextureLoadStatus::DECODED, std::memory_order_release);
+
+		std::lock_guard<std::mutex> lock(uploadsMutex_);
+		uploads_.push_back(state);
+	}
+}
\ No newline at end of file
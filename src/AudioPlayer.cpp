@@ -52,10 +52,10 @@ bool Evolve::AudioPlayer::init() {
 
 size_t Evolve::AudioPlayer::addSoundEffect(const std::string& path) {
 
-	auto effect = soundEffectCache_.find(path);
+	const size_t* cachedID = soundEffectCache_.find(StringId(path.c_str()));
 
-	if (effect != soundEffectCache_.end()) {
-		return effect->second.second;
+	if (cachedID != nullptr) {
+		return *cachedID;
 	}
 	else {
 		Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
@@ -71,17 +71,17 @@ size_t Evolve::AudioPlayer::addSoundEffect(const std::string& path) {
 
 		size_t id = soundEffects_.size() - 1;
 
-		soundEffectCache_.insert(std::make_pair(path, std::make_pair(chunk, id)));
+		soundEffectCache_[StringId::intern(path)] = id;
 
 		return id;
 	}
 }
 
 size_t Evolve::AudioPlayer::addMusic(const std::string& path) {
-	auto effect = musicCache_.find(path);
+	const size_t* cachedID = musicCache_.find(StringId(path.c_str()));
 
-	if (effect != musicCache_.end()) {
-		return effect->second.second;
+	if (cachedID != nullptr) {
+		return *cachedID;
 	}
 	else {
 		Mix_Music* music = Mix_LoadMUS(path.c_str());
@@ -97,7 +97,7 @@ size_t Evolve::AudioPlayer::addMusic(const std::string& path) {
 
 		size_t id = musics_.size() - 1;
 
-		musicCache_.insert(std::make_pair(path, std::make_pair(music, id)));
+		musicCache_[StringId::intern(path)] = id;
 
 		return id;
 	}
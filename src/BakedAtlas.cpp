@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/BakedAtlas.h"
+
+Evolve::BakedAtlas::BakedAtlas() {}
+
+Evolve::BakedAtlas::~BakedAtlas() {
+	freeBakedAtlas();
+}
+
+bool Evolve::BakedAtlas::loadFromFile(const std::string& filePath) {
+	freeBakedAtlas();
+
+	MappedFile file;
+
+	if (!file.openFile(filePath)) {
+		EVOLVE_REPORT_ERROR("Failed to map the baked atlas file.", loadFromFile);
+		return false;
+	}
+
+	if (!validateFile(file, filePath)) {
+		return false;
+	}
+
+	const unsigned char* data = file.getData();
+
+	BakedAtlasHeader header;
+	memcpy(&header, data, sizeof(header));
+
+	const BakedAtlasLevel* levels = (const BakedAtlasLevel*) (data + header.LevelTableOffset);
+
+	GLenum pixelFormat = header.ColorChannels == 1 ? GL_RED : GL_RGBA;
+	GLint internalFormat = header.ColorChannels == 1 ? GL_RED : GL_RGBA8;
+
+	pageTextureIDs_.resize(header.NumPages);
+	glGenTextures((GLsizei) header.NumPages, pageTextureIDs_.data());
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (uint32_t page = 0; page < header.NumPages; page++) {
+		glBindTexture(GL_TEXTURE_2D, pageTextureIDs_[page]);
+
+		// the driver copies the pixels out of the mapping, touching each page of the file once
+		for (uint32_t level = 0; level < header.NumMipLevels; level++) {
+			const BakedAtlasLevel& bakedLevel = levels[page * header.NumMipLevels + level];
+
+			glTexImage2D(GL_TEXTURE_2D, level, internalFormat, bakedLevel.Width, bakedLevel.Height,
+				0, pixelFormat, GL_UNSIGNED_BYTE, data + bakedLevel.Offset);
+		}
+
+		if (header.ColorChannels == 1) {
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+		}
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, 
+			header.NumMipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.NumMipLevels - 1);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	const BakedAtlasSprite* sprites = (const BakedAtlasSprite*) (data + header.SpriteTableOffset);
+	const char* names = (const char*) (data + header.NameBlobOffset);
+
+	regions_.reserve(header.NumSprites);
+
+	for (uint32_t i = 0; i < header.NumSprites; i++) {
+		const BakedAtlasSprite& sprite = sprites[i];
+
+		AtlasRegion region;
+		region.TextureID = pageTextureIDs_[sprite.Page];
+		region.Page = sprite.Page;
+		region.X = sprite.X;
+		region.Y = sprite.Y;
+		region.Width = sprite.Width;
+		region.Height = sprite.Height;
+
+		// the rows of the page go from the top and v goes from the bottom
+		region.Uv.set(
+			(float) sprite.X / header.PageWidth,
+			1.0f - (float) (sprite.Y + sprite.Height) / header.PageHeight,
+			(float) sprite.Width / header.PageWidth,
+			(float) sprite.Height / header.PageHeight
+		);
+
+		regions_[std::string(names + sprite.NameOffset, sprite.NameLength)] = region;
+	}
+
+	return true;
+}
+
+bool Evolve::BakedAtlas::getRegion(const std::string& name, AtlasRegion& region) const {
+	auto it = regions_.find(name);
+
+	if (it == regions_.end()) {
+		return false;
+	}
+
+	region = it->second;
+	return true;
+}
+
+GLuint Evolve::BakedAtlas::getPageTextureID(const unsigned int page) const {
+	if (page >= pageTextureIDs_.size()) {
+		EVOLVE_REPORT_ERROR("Invalid atlas page used.", getPageTextureID);
+		return 0;
+	}
+
+	return pageTextureIDs_[page];
+}
+
+void Evolve::BakedAtlas::freeBakedAtlas() {
+	if (!pageTextureIDs_.empty()) {
+		glDeleteTextures((GLsizei) pageTextureIDs_.size(), pageTextureIDs_.data());
+		pageTextureIDs_.clear();
+	}
+
+	regions_.clear();
+}
+
+bool Evolve::BakedAtlas::validateFile(const MappedFile& file, const std::string& filePath) {
+	std::string errStr = filePath + " is not a valid baked atlas file.";
+
+	const uint64_t fileSize = file.getSize();
+
+	if (fileSize < sizeof(BakedAtlasHeader)) {
+		EVOLVE_REPORT_ERROR(errStr.c_str(), validateFile);
+		return false;
+	}
+
+	BakedAtlasHeader header;
+	memcpy(&header, file.getData(), sizeof(header));
+
+	if (memcmp(header.Magic, BAKED_ATLAS_MAGIC, sizeof(header.Magic)) != 0 || 
+		header.Version != BAKED_ATLAS_VERSION ||
+		(header.ColorChannels != 1 && header.ColorChannels != 4) ||
+		header.NumMipLevels == 0 || header.PageWidth == 0 || header.PageHeight == 0) {
+		EVOLVE_REPORT_ERROR(errStr.c_str(), validateFile);
+		return false;
+	}
+
+	// every table and level must lie inside the file, the tables must be aligned to be read in place
+	auto inFile = [fileSize](uint64_t offset, uint64_t size) {
+		return offset <= fileSize && size <= fileSize - offset;
+	};
+
+	uint64_t numLevels = (uint64_t) header.NumPages * header.NumMipLevels;
+
+	if (!inFile(header.SpriteTableOffset, (uint64_t) header.NumSprites * sizeof(BakedAtlasSprite)) ||
+		!inFile(header.NameBlobOffset, header.NameBlobSize) ||
+		!inFile(header.LevelTableOffset, numLevels * sizeof(BakedAtlasLevel)) ||
+		header.SpriteTableOffset % alignof(BakedAtlasSprite) != 0 ||
+		header.LevelTableOffset % alignof(BakedAtlasLevel) != 0) {
+		EVOLVE_REPORT_ERROR(errStr.c_str(), validateFile);
+		return false;
+	}
+
+	const BakedAtlasLevel* levels = (const BakedAtlasLevel*) (file.getData() + header.LevelTableOffset);
+
+	for (uint64_t i = 0; i < numLevels; i++) {
+		uint64_t expectedSize = (uint64_t) levels[i].Width * levels[i].Height * header.ColorChannels;
+
+		if (levels[i].Size != expectedSize || !inFile(levels[i].Offset, levels[i].Size)) {
+			EVOLVE_REPORT_ERROR(errStr.c_str(), validateFile);
+			return false;
+		}
+	}
+
+	const BakedAtlasSprite* sprites = (const BakedAtlasSprite*) (file.getData() + header.SpriteTableOffset);
+
+	for (uint32_t i = 0; i < header.NumSprites; i++) {
+		if (sprites[i].Page >= header.NumPages || 
+			(uint64_t) sprites[i].NameOffset + sprites[i].NameLength > header.NameBlobSize) {
+			EVOLVE_REPORT_ERROR(errStr.c_str(), validateFile);
+			return false;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -22,6 +22,10 @@ SOFTWARE.
 
 #include "../include/Evolve/Camera.h"
 
+namespace {
+	constexpr Evolve::StringId MVP_MATRIX_UNIFORM("u_mvpMatrix");
+}
+
 Evolve::Camera::Camera() {}
 
 Evolve::Camera::~Camera() {}
@@ -39,7 +43,7 @@ bool Evolve::Camera::init(const Size2D& screenSize) {
 }
 
 void Evolve::Camera::sendMatrixDataToShader(GlslProgram& shaderProgram) {
-	GLint mvpLoc = shaderProgram.getUniformLocation("u_mvpMatrix");
+	GLint mvpLoc = shaderProgram.getUniformLocation(MVP_MATRIX_UNIFORM);
 	glUniformMatrix4fv(mvpLoc, 1, GL_FALSE, &mvp_[0][0]);
 }
 
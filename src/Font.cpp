@@ -22,6 +22,8 @@ SOFTWARE.
 
 #include "../include/Evolve/Font.h"
 
+unsigned int Evolve::Font::lastGeneration_ = 0;
+
 Evolve::Font::Font() { }
 
 Evolve::Font::~Font() {
@@ -32,6 +34,8 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 	const float fontScale /*= 1.0f*/, const int letterSpacing /*= 5*/, 
 	const int lineSpacing /*= 5*/, const int addToSpaceLength /*= 0*/) {
 
+	deleteFont();
+
 	ImageLoader::LoadTextureFromImage(bmpFilePath, fontTexture_, 1);
 
 	if (fontTexture_.data == nullptr) {
@@ -52,6 +56,8 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 	int currentPixelX = 0, currentPixelY = 0;
 
 	UvDimension currentUV = {};
+	UvDimension uvDimensions[256] {};
+	int characterWidths[256] {};
 
 	unsigned int currentChar = 0;
 
@@ -131,7 +137,7 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 						currentUV.BottomLeftX = (float) currentPixelX / (float) fontTexture_.width;
 
 						// the left of current character
-						characterWidths_[currentChar] = j;
+						characterWidths[currentChar] = j;
 
 						i = CELL_HEIGHT;
 						j = CELL_WIDTH;
@@ -153,7 +159,7 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 							( ( (float) currentPixelX + 1) / (float) fontTexture_.width ) - currentUV.BottomLeftX;
 
 						// now setting the actual Width
-						characterWidths_[currentChar] = j - characterWidths_[currentChar];
+						characterWidths[currentChar] = j - characterWidths[currentChar];
 
 						i = CELL_HEIGHT;
 						j = -1;
@@ -161,7 +167,7 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 				}
 			}
 
-			uvDimensions_[currentChar] = currentUV;
+			uvDimensions[currentChar] = currentUV;
 			currentChar++;
 		}
 	}
@@ -173,8 +179,18 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 	newLine_ = aBottom - top;
 	lineHeight_ = bottom - top;
 
+	ascender_ = newLine_;
+
 	for (int i = 0; i < 256; i++) {
-		uvDimensions_[i].Height = (float)lineHeight_ / (float)fontTexture_.height;
+		Glyph& glyph = *glyphs_.tryEmplace((uint32_t) i).first;
+
+		glyph.TextureID = fontTexture_.id;
+		glyph.Uv = uvDimensions[i];
+		glyph.Uv.Height = (float)lineHeight_ / (float)fontTexture_.height;
+
+		glyph.Width = characterWidths[i];
+		glyph.Height = lineHeight_;
+		glyph.Advance = characterWidths[i];
 	}
 
 	fontName_ = fontName;
@@ -188,249 +204,162 @@ bool Evolve::Font::initFromBitmap16x16(const char* fontName, const char* bmpFile
 	return true;
 }
 
+
 bool Evolve::Font::initFromFontFile(const char* fontName, const char* fontFilePath,
 	const unsigned int fontSize /*= 32*/,
 	const float fontScale /*= 1.0f*/, const int letterSpacing /*= 5*/, 
 	const int lineSpacing /*= 5*/, const int addToSpaceLength /*= 0*/) {
 
-	const unsigned int TOTAL_FONTS = 256;
+	deleteFont();
 
-	static FT_Library library;
-	FT_Error error = FT_Init_FreeType(&library);
-	if (error) {
-		EVOLVE_REPORT_ERROR("Failed to initialize FreeType.", initFromFontFile);
+	if (!FontFaceCache::AcquireFace(fontFilePath, fontSize, ftFace_, ftSize_)) {
+		EVOLVE_REPORT_ERROR("Failed to load font face.", initFromFontFile);
+
+		ftFace_ = nullptr;
+		ftSize_ = nullptr;
 		return false;
 	}
 
-	int maxCellWidth = 0;
-	int maxCellHeight = 0;
-	int maxBearing = 0;
-	int maxHang = 0;
-
-	std::vector<TextureData> characterTextures;
-	characterTextures.resize(TOTAL_FONTS);
+	FT_Activate_Size(ftSize_);
 
-	std::vector<FT_Glyph_Metrics> characterMetrics;
-	characterMetrics.resize(TOTAL_FONTS);
+	// a page holds a few hundred glyphs of a small font, big fonts get bigger pages
+	int pageSize = 512;
 
-	FT_Face face = 0;
-	error = FT_New_Face(library, fontFilePath, 0, &face);
-	if (error) {
-		EVOLVE_REPORT_ERROR("Failed to create font face.", initFromFontFile);
-
-		FT_Done_FreeType(library);
-		return false;
+	while (pageSize < (int) fontSize * 8 && pageSize < 4096) {
+		pageSize *= 2;
 	}
 
-	error = FT_Set_Pixel_Sizes(face, 0, fontSize);
-	if (error) {
-		EVOLVE_REPORT_ERROR("Failed to set font size.", initFromFontFile);
+	// glyphs are only looked up through the glyph table, so the atlas keeps neither names nor page copies
+	if (!glyphAtlas_.init(pageSize, pageSize, 1, 1, false)) {
+		EVOLVE_REPORT_ERROR("Failed to create the glyph atlas.", initFromFontFile);
 
-		FT_Done_Face(face);
-		FT_Done_FreeType(library);
+		deleteFont();
 		return false;
 	}
 
-	for (int i = 0; i < TOTAL_FONTS; i++) {
-
-		error = FT_Load_Char(face, i, FT_LOAD_RENDER);
-		if (error) {
-			std::string errStr = "Failed to load character " + std::to_string((char)i) + ".";
+	// the size metrics are 26.6 fixed point, the descender is negative
+	const FT_Size_Metrics& metrics = ftSize_->metrics;
 
-			EVOLVE_REPORT_ERROR(errStr.c_str(), initFromFontFile);
+	ascender_ = (int) ((metrics.ascender + 63) >> 6);
+	int descender = (int) (metrics.descender >> 6);
 
-			FT_Done_Face(face);
-			FT_Done_FreeType(library);
-			return false;
-		}
-
-		characterMetrics[i] = face->glyph->metrics;
-
-		characterTextures[i].width = face->glyph->bitmap.width;
-		characterTextures[i].height = face->glyph->bitmap.rows;
+	newLine_ = ascender_;
+	lineHeight_ = ascender_ - descender;
 
-		characterTextures[i].data = new unsigned char[characterTextures[i].width * characterTextures[i].height];
+	FT_Error error = FT_Load_Char(ftFace_, ' ', FT_LOAD_DEFAULT);
+	spaceSize_ = error ? fontSize / 4 : (unsigned int) ((ftFace_->glyph->advance.x + 32) >> 6);
 
-		memcpy(characterTextures[i].data, face->glyph->bitmap.buffer,
-			(size_t) characterTextures[i].width * characterTextures[i].height);
+	fontName_ = fontName;
+	initialized_ = true;
 
-		if (characterMetrics[i].horiBearingY / 64 > maxBearing) {
-			maxBearing = characterMetrics[i].horiBearingY / 64;
-		}
+	letterSpacing_ = letterSpacing;
+	lineSpacing_ = lineSpacing;
+	addToSpaceLength_ = addToSpaceLength;
+	fontScale_ = fontScale;
 
-		if (characterMetrics[i].width / 64 > maxCellWidth) {
-			maxCellWidth = characterMetrics[i].width / 64;
+	return true;
+}
 
-		}
+bool Evolve::Font::initSdfFromFontFile(const char* fontName, const char* fontFilePath, 
+	const unsigned int baseSize /*= 48*/,
+	const float fontScale /*= 1.0f*/, const int letterSpacing /*= 0*/,
+	const int lineSpacing /*= 0*/, const int addToSpaceLength /*= 0*/) {
 
-		int glyphHang = (characterMetrics[i].height - characterMetrics[i].horiBearingY) / 64;
-		if (glyphHang > maxHang)
-		{
-			maxHang = glyphHang;
-		}
+#ifdef EVOLVE_FREETYPE_SDF
+	if (!initFromFontFile(fontName, fontFilePath, baseSize, fontScale, letterSpacing, lineSpacing, addToSpaceLength)) {
+		return false;
 	}
 
-	maxCellHeight = maxBearing + maxHang;
-
-	unsigned int textureWidth = maxCellWidth * 16;
-	unsigned int textureHeight = maxCellHeight * 16;
-
-	fontTexture_.data = new unsigned char[textureWidth * textureHeight];
-	memset(fontTexture_.data, 0, (size_t) textureWidth * textureHeight);
-
-	fontTexture_.width = textureWidth;
-	fontTexture_.height = textureHeight;
-	fontTexture_.bitsPerPixel = 1;
-
-	UvDimension currentUV = {};
-	unsigned int currentChar = 0;
-
-	unsigned int currentCellX = 0;
-	unsigned int currentCellY = 0;
-
-	for (int row = 0; row < 16; row++) {
-		for (int column = 0; column < 16; column++) {
-
-			currentCellX = maxCellWidth * column;
-			currentCellY = maxCellHeight * row;
-
-			currentUV.set(
-				(float)maxCellWidth * column / (float)fontTexture_.width,
-
-				// if texture Height is 10 and cell Height is 2
-				// for row = 0, (10 - ((0 + 1) * 2)) = 10 - 2 = 8
-				// for row = 1, (10 - ((1 + 1) * 2)) = 10 - 4 = 6
-				// for row = 4, (10 - ((4 + 1) * 2)) = 10 - 10 = 10
-				(float)(fontTexture_.height - ((row + 1) * maxCellHeight)) / (float)fontTexture_.height,
-
-
-				(float)(characterMetrics[currentChar].width / 64) / (float)fontTexture_.width,
-				(float)maxCellHeight / (float)fontTexture_.height
-			);
-
-			uvDimensions_[currentChar] = currentUV;
-			characterWidths_[currentChar] = characterMetrics[currentChar].width / 64;
-
-			int currentCharTop = currentCellY + maxBearing - characterMetrics[currentChar].horiBearingY / 64;
-
-			unsigned char* destPixels = fontTexture_.data;
-			unsigned char* srcPixels = characterTextures[currentChar].data;
-
-			for (int i = 0; i < characterTextures[currentChar].height; i++) {
+	// no glyph is rasterized during init, so they're all rendered as distance fields
+	sdf_ = true;
+	return true;
+#else
+	EVOLVE_REPORT_ERROR("Distance field fonts need FreeType 2.11 or newer.", initSdfFromFontFile);
+	return false;
+#endif
+}
 
-				memcpy(
-					&destPixels[(i + currentCharTop) * fontTexture_.width + currentCellX],
-					&srcPixels[i * characterTextures[currentChar].width],
-					characterTextures[currentChar].width
-				);
-			}
+bool Evolve::Font::initSizesFromFontFile(const char* fontName, const char* fontFilePath,
+	const std::vector<Font*>& fonts, const std::vector<unsigned int>& fontSizes,
+	const float fontScale /*= 1.0f*/, const int letterSpacing /*= 0*/,
+	const int lineSpacing /*= 0*/, const int addToSpaceLength /*= 0*/) {
 
-			currentChar++;
-		}
+	if (fonts.size() != fontSizes.size()) {
+		EVOLVE_REPORT_ERROR("Number of fonts and font sizes don't match.", initSizesFromFontFile);
+		return false;
 	}
 
-	ImageLoader::BufferTextureData(fontTexture_);
-
-	delete[] fontTexture_.data;
-	fontTexture_.data = nullptr;
+	// holding a size keeps the face open, in case a font being reloaded held its last one
+	FT_Face face = nullptr;
+	FT_Size size = nullptr;
 
-	for (auto& it : characterTextures) {
-		delete[] it.data;
-		it.data = nullptr;
+	if (!FontFaceCache::AcquireFace(fontFilePath, fontSizes.empty() ? 32 : fontSizes[0], face, size)) {
+		EVOLVE_REPORT_ERROR("Failed to load font face.", initSizesFromFontFile);
+		return false;
 	}
 
-	FT_Done_Face(face);
-	FT_Done_FreeType(library);
+	bool allLoaded = true;
 
-	spaceSize_ = maxCellWidth / 2;
-	newLine_ = maxBearing;
-	lineHeight_ = maxCellHeight;
-
-	for (int i = 0; i < 256; i++) {
-		uvDimensions_[i].Height = (float)lineHeight_ / (float)fontTexture_.height;
+	for (size_t i = 0; i < fonts.size(); i++) {
+		allLoaded = fonts[i]->initFromFontFile(fontName, fontFilePath, fontSizes[i], 
+			fontScale, letterSpacing, lineSpacing, addToSpaceLength) && allLoaded;
 	}
 
-	fontName_ = fontName;
-	initialized_ = true;
+	FontFaceCache::ReleaseFace(face, size);
 
-	letterSpacing_ = letterSpacing;
-	lineSpacing_ = lineSpacing;
-	addToSpaceLength_ = addToSpaceLength;
-	fontScale_ = fontScale;
+	return allLoaded;
+}
 
-	return true;
+void Evolve::Font::preloadGlyphs(const char* text) const {
+	size_t i = 0;
+
+	while (text[i] != '\0') {
+		getGlyph(decodeUtf8(text, i));
+	}
 }
 
 void Evolve::Font::drawTextToRenderer(const char* text, const int topLeftX, const int topLeftY,
 	const ColorRgba& color, TextureRenderer& textureRenderer) const {
 
-	if (fontTexture_.id == 0) {
+	if (!initialized_) {
 		EVOLVE_REPORT_ERROR("Didn't load any font yet.", drawTextToRenderer);
 		return;
 	}
 
-	/*textureRenderer.draw(
-		GlyphOrigin::BOTTOM_LEFT,
-		RectDimension { 0,0,700,700 },
-		UvDimension { 0.0f, 0.0f, 1.0f, 1.0f },
-		fontTexture_.id, ColorRgba { 255,255,255,255 }
-	);*/
-
-	int drawX = topLeftX;
-	int drawY = topLeftY;
-	
-	RectDimension currentDims;
-
-	int i = 0;
-
-	while (text[i] != '\0') {
-		if (text[i] == ' ') {
-			drawX += (int) ((spaceSize_ + addToSpaceLength_) * fontScale_);
-		}
-		else if (text[i] == '\n') {
-			drawX = topLeftX;
-			drawY -= (int) ((newLine_ + lineSpacing_) * fontScale_);
-		}
-		else {
-			unsigned int ASCII = (unsigned char) text[i];
-
-			currentDims.set(
-				Origin::TOP_LEFT,
-				drawX,
-				drawY,
-				(unsigned int) (characterWidths_[ASCII] * fontScale_),
-				(unsigned int) (lineHeight_ * fontScale_)
-			);
-
-			textureRenderer.draw(
-				currentDims,
-				uvDimensions_[ASCII],
-				fontTexture_.id,
-				color
-			);
-
-			drawX += (int) ((characterWidths_[ASCII] + letterSpacing_) * fontScale_);
-		}
-		i++;
-	}
+	drawLayout_.update(*this, text);
+	drawLayout_.draw(textureRenderer, topLeftX, topLeftY, color);
 }
 
 unsigned int Evolve::Font::getLineWidth(const char* text) const {
 
 	int width = 0;
-	int i = 0;
+	size_t i = 0;
+
+	// kerned like TextLayout does by default
+	unsigned int previousGlyph = 0;
 
 	while (text[i] != '\0') {
-		if (text[i] == '\n') {
+		uint32_t codePoint = decodeUtf8(text, i);
+
+		if (codePoint == '\n') {
 			break;
 		}
-		else if (text[i] == ' ') {
+		else if (codePoint == ' ') {
 			width += (int) ((spaceSize_ + addToSpaceLength_) * fontScale_);
+			previousGlyph = 0;
 		}
 		else {
-			width += (int) ((characterWidths_[(unsigned char)text[i]] + letterSpacing_) * fontScale_);
+			const Glyph* glyph = getGlyph(codePoint);
+
+			if (glyph != nullptr) {
+				if (previousGlyph != 0) {
+					width += (int) (getKerning(previousGlyph, glyph->GlyphIndex) * fontScale_);
+				}
+
+				width += (int) ((glyph->Advance + letterSpacing_) * fontScale_);
+				previousGlyph = glyph->GlyphIndex;
+			}
 		}
-		i++;
 	}
 	return width;
 }
@@ -455,4 +384,147 @@ unsigned int Evolve::Font::getTextHeight(const char* text) const {
 
 void Evolve::Font::deleteFont() {
 	ImageLoader::DeleteTexture(fontTexture_);
+
+	glyphAtlas_.freeTextureAtlas();
+	glyphs_.clear();
+	kerningPairs_.clear();
+
+	FontFaceCache::ReleaseFace(ftFace_, ftSize_);
+
+	ftFace_ = nullptr;
+	ftSize_ = nullptr;
+
+	initialized_ = false;
+	sdf_ = false;
+
+	newGeneration();
+}
+
+const Evolve::Font::Glyph* Evolve::Font::getGlyph(const uint32_t codePoint) const {
+	const Glyph* cachedGlyph = glyphs_.find(codePoint);
+
+	if (cachedGlyph != nullptr) {
+		return cachedGlyph;
+	}
+
+	// bitmap fonts have all their glyphs from the start
+	if (ftFace_ == nullptr) {
+		return nullptr;
+	}
+
+	Glyph glyph;
+	FT_UInt glyphIndex = FT_Get_Char_Index(ftFace_, codePoint);
+
+	// code points missing from the font share its .notdef glyph, which is cached as code point 0
+	if (glyphIndex == 0 && codePoint != 0) {
+		const Glyph* notDefGlyph = getGlyph(0);
+
+		if (notDefGlyph != nullptr) {
+			glyph = *notDefGlyph;
+		}
+	}
+	else {
+		rasterizeGlyph(glyphIndex, glyph);
+		glyph.GlyphIndex = glyphIndex;
+	}
+
+	// glyphs that fail to rasterize are cached empty, so they're only reported once
+	Glyph* insertedGlyph = glyphs_.tryEmplace(codePoint).first;
+	*insertedGlyph = glyph;
+
+	return insertedGlyph;
+}
+
+void Evolve::Font::rasterizeGlyph(const unsigned int glyphIndex, Glyph& glyph) const {
+
+	// other fonts of the same file may have activated their sizes since
+	FT_Activate_Size(ftSize_);
+
+	FT_Error error = FT_Load_Glyph(ftFace_, glyphIndex, sdf_ ? FT_LOAD_DEFAULT : FT_LOAD_RENDER);
+
+#ifdef EVOLVE_FREETYPE_SDF
+	// the distance field is padded by the spread on every side, the bitmap offsets include it
+	if (!error && sdf_) {
+		error = FT_Render_Glyph(ftFace_->glyph, FT_RENDER_MODE_SDF);
+	}
+#endif
+
+	if (error) {
+		std::string errStr = "Failed to load glyph " + std::to_string(glyphIndex) + ".";
+
+		EVOLVE_REPORT_ERROR(errStr.c_str(), rasterizeGlyph);
+		return;
+	}
+
+	FT_GlyphSlot slot = ftFace_->glyph;
+	const FT_Bitmap& bitmap = slot->bitmap;
+
+	glyph.Advance = (int) ((slot->advance.x + 32) >> 6);
+	glyph.OffsetX = slot->bitmap_left;
+	glyph.OffsetY = ascender_ - slot->bitmap_top;
+	glyph.Width = (int) bitmap.width;
+	glyph.Height = (int) bitmap.rows;
+
+	if (glyph.Width == 0 || glyph.Height == 0) {
+		return;
+	}
+
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		std::string errStr = "Glyph " + std::to_string(glyphIndex) + " isn't rendered in grayscale.";
+
+		EVOLVE_REPORT_ERROR(errStr.c_str(), rasterizeGlyph);
+
+		glyph.Width = glyph.Height = 0;
+		return;
+	}
+
+	// the atlas takes tightly packed rows, the bitmap's rows may be padded
+	const unsigned char* pixels = bitmap.buffer;
+	std::vector<unsigned char> packedPixels;
+
+	if (bitmap.pitch != glyph.Width) {
+		packedPixels.resize((size_t) glyph.Width * glyph.Height);
+
+		for (int row = 0; row < glyph.Height; row++) {
+			const unsigned char* srcRow = bitmap.pitch > 0 ?
+				bitmap.buffer + (size_t) row * bitmap.pitch :
+				bitmap.buffer + (size_t) (glyph.Height - 1 - row) * -bitmap.pitch;
+
+			memcpy(&packedPixels[(size_t) row * glyph.Width], srcRow, glyph.Width);
+		}
+
+		pixels = packedPixels.data();
+	}
+
+	AtlasRegion region;
+
+	if (!glyphAtlas_.addPixels(pixels, glyph.Width, glyph.Height, region)) {
+		return;
+	}
+
+	glyph.TextureID = region.TextureID;
+	glyph.Uv = region.Uv;
+}
+
+int Evolve::Font::getKerning(const unsigned int leftGlyphIndex, const unsigned int rightGlyphIndex) const {
+	if (ftFace_ == nullptr || !FT_HAS_KERNING(ftFace_)) {
+		return 0;
+	}
+
+	uint64_t pairKey = ((uint64_t) leftGlyphIndex << 32) | rightGlyphIndex;
+
+	auto inserted = kerningPairs_.tryEmplace(pairKey);
+
+	if (!inserted.second) {
+		return *inserted.first;
+	}
+
+	// the kerning is scaled to the active size
+	FT_Activate_Size(ftSize_);
+
+	FT_Vector kerning {};
+	FT_Get_Kerning(ftFace_, leftGlyphIndex, rightGlyphIndex, FT_KERNING_DEFAULT, &kerning);
+
+	*inserted.first = (int) (kerning.x >> 6);
+	return *inserted.first;
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/FontFaceCache.h"
+
+FT_Library Evolve::FontFaceCache::library_ = nullptr;
+Evolve::FlatHashMap<Evolve::StringId, Evolve::FontFaceCache::CachedFace, Evolve::StringIdHash> Evolve::FontFaceCache::faces_;
+
+bool Evolve::FontFaceCache::AcquireFace(const std::string& fontFilePath, const unsigned int pixelSize, 
+	FT_Face& face, FT_Size& size) {
+
+	if (library_ == nullptr) {
+		FT_Error error = FT_Init_FreeType(&library_);
+		if (error) {
+			EVOLVE_REPORT_ERROR("Failed to initialize FreeType.", AcquireFace);
+
+			library_ = nullptr;
+			return false;
+		}
+
+#ifdef EVOLVE_FREETYPE_SDF
+		// the default spread of 2 pixels is too thin for outlines and shadows
+		FT_Int spread = SDF_SPREAD;
+		FT_Property_Set(library_, "sdf", "spread", &spread);
+		FT_Property_Set(library_, "bsdf", "spread", &spread);
+#endif
+	}
+
+	CachedFace* cachedFace = faces_.find(StringId(fontFilePath.c_str()));
+
+	if (cachedFace == nullptr) {
+		CachedFace newFace;
+
+		if (!openFace(fontFilePath, newFace)) {
+			if (faces_.empty()) {
+				FT_Done_FreeType(library_);
+				library_ = nullptr;
+			}
+			return false;
+		}
+
+		// the key must keep its string, the path only lives for this call
+		cachedFace = faces_.tryEmplace(StringId::intern(fontFilePath)).first;
+		*cachedFace = std::move(newFace);
+	}
+
+	// counted before creating the size, so releasing on failure closes a face nothing else uses
+	cachedFace->Refs++;
+
+	FT_Face sharedFace = cachedFace->Face;
+	FT_Size newSize = nullptr;
+
+	FT_Error error = FT_New_Size(sharedFace, &newSize);
+	if (error) {
+		EVOLVE_REPORT_ERROR("Failed to create font size.", AcquireFace);
+
+		ReleaseFace(sharedFace, nullptr);
+		return false;
+	}
+
+	// setting the pixel size needs the size to be active, the previously active one is restored after
+	FT_Size activeSize = sharedFace->size;
+
+	FT_Activate_Size(newSize);
+	error = FT_Set_Pixel_Sizes(sharedFace, 0, pixelSize);
+
+	if (activeSize != nullptr) {
+		FT_Activate_Size(activeSize);
+	}
+
+	if (error) {
+		EVOLVE_REPORT_ERROR("Failed to set font size.", AcquireFace);
+
+		ReleaseFace(sharedFace, newSize);
+		return false;
+	}
+
+	face = sharedFace;
+	size = newSize;
+
+	return true;
+}
+
+void Evolve::FontFaceCache::ReleaseFace(FT_Face face, FT_Size size) {
+	if (face == nullptr) {
+		return;
+	}
+
+	if (size != nullptr) {
+		FT_Done_Size(size);
+	}
+
+	const StringId* releasedPath = nullptr;
+
+	faces_.forEach([&](const StringId& path, CachedFace& cachedFace) {
+		if (cachedFace.Face == face) {
+			releasedPath = &path;
+		}
+	});
+
+	if (releasedPath == nullptr) {
+		EVOLVE_REPORT_ERROR("Releasing a font face that isn't cached.", ReleaseFace);
+		return;
+	}
+
+	CachedFace& cachedFace = *faces_.find(*releasedPath);
+
+	if (cachedFace.Refs > 0) {
+		cachedFace.Refs--;
+	}
+
+	if (cachedFace.Refs > 0) {
+		return;
+	}
+
+	FT_Done_Face(cachedFace.Face);
+	cachedFace.File->closeFile();
+
+	// the key is copied, erasing moves the entries
+	faces_.erase(StringId(*releasedPath));
+
+	if (faces_.empty()) {
+		FT_Done_FreeType(library_);
+		library_ = nullptr;
+	}
+}
+
+bool Evolve::FontFaceCache::openFace(const std::string& fontFilePath, CachedFace& cachedFace) {
+	cachedFace.File = std::make_unique<MappedFile>();
+
+	if (!cachedFace.File->openFile(fontFilePath, MappedFileAccess::RANDOM)) {
+		std::string errStr = "Failed to open font file at " + fontFilePath + ".";
+
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFace);
+		return false;
+	}
+
+	FT_Error error = FT_New_Memory_Face(library_, cachedFace.File->getData(), (FT_Long) cachedFace.File->getSize(), 
+		0, &cachedFace.Face);
+
+	if (error) {
+		std::string errStr = "Failed to create font face from " + fontFilePath + ".";
+
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFace);
+
+		cachedFace.Face = nullptr;
+		cachedFace.File->closeFile();
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
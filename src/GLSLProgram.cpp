@@ -73,29 +73,40 @@ bool Evolve::GlslProgram::compileAndLinkShaders(const std::string& vertexShaderP
 	return true;
 }
 
-GLint Evolve::GlslProgram::getUniformLocation(const std::string& uniformName) {
+GLint Evolve::GlslProgram::getUniformLocation(const StringId& uniformId) {
 	
-	auto it = m_uniformCache.find(uniformName);
+	const GLint* cachedLocation = m_uniformCache.find(uniformId);
 
-	if (it != m_uniformCache.end()) {
-		return it->second;
+	if (cachedLocation != nullptr) {
+		return *cachedLocation;
 	}
 	else {
-		GLint location = glGetUniformLocation(programID_, uniformName.c_str());
+		GLint location = glGetUniformLocation(programID_, uniformId.getString());
 
 		if (location == GL_INVALID_INDEX) {
-			std::string errStr = "Uniform " + std::string(uniformName) + " was not found in the shader.";
+			std::string errStr = "Uniform " + std::string(uniformId.getString()) + " was not found in the shader.";
 
 			EVOLVE_REPORT_ERROR(errStr.c_str(), getUniformLocation);
 		}
 		else {
-			m_uniformCache.insert(make_pair(uniformName, location));
+			m_uniformCache[uniformId] = location;
 		}
 
 		return location;
 	}
 }
 
+GLint Evolve::GlslProgram::getUniformLocation(const std::string& uniformName) {
+	// the name only lives for this call, so it's interned if it becomes a key
+	StringId uniformId(uniformName.c_str());
+
+	if (!m_uniformCache.contains(uniformId)) {
+		uniformId = StringId::intern(uniformName);
+	}
+
+	return getUniformLocation(uniformId);
+}
+
 void Evolve::GlslProgram::useProgram() {
 	glUseProgram(programID_);
 }
@@ -78,8 +78,9 @@ void Evolve::GuiRenderer::renderGui(Gui& gui, Camera& camera) {
 					button->labelCoordinatesFound_ = true;
 				}
 
-				font->drawTextToRenderer(button->label_, button->labelTopLeftX_,
-					button->labelTopLeftY_, button->primaryColor_, textureRenderer_);
+				button->labelLayout_.update(*font, button->label_);
+				button->labelLayout_.draw(textureRenderer_, button->labelTopLeftX_,
+					button->labelTopLeftY_, button->primaryColor_);
 			}
 
 			// PLAIN TEXT
@@ -90,8 +91,9 @@ void Evolve::GuiRenderer::renderGui(Gui& gui, Camera& camera) {
 
 				font->setFontScale(plainText->labelScale_);
 
-				font->drawTextToRenderer(plainText->label_, plainText->dimension_.getLeft(),
-					plainText->dimension_.getTop(), plainText->primaryColor_, textureRenderer_);
+				plainText->labelLayout_.update(*font, plainText->label_);
+				plainText->labelLayout_.draw(textureRenderer_, plainText->dimension_.getLeft(),
+					plainText->dimension_.getTop(), plainText->primaryColor_);
 			}
 
 			// BLINKING_TEXT
@@ -105,8 +107,9 @@ void Evolve::GuiRenderer::renderGui(Gui& gui, Camera& camera) {
 
 					font->setFontScale(blinkingText->labelScale_);
 
-					font->drawTextToRenderer(blinkingText->label_, blinkingText->dimension_.getLeft(),
-						blinkingText->dimension_.getTop(), blinkingText->primaryColor_, textureRenderer_);
+					blinkingText->labelLayout_.update(*font, blinkingText->label_);
+					blinkingText->labelLayout_.draw(textureRenderer_, blinkingText->dimension_.getLeft(),
+						blinkingText->dimension_.getTop(), blinkingText->primaryColor_);
 				}
 				else {
 					if (blinkingText->time_ > blinkingText->onDuration_ + blinkingText->offDuration_) {
@@ -22,7 +22,19 @@ SOFTWARE.
 
 #include "../include/Evolve/ImageLoader.h"
 
-std::map<std::string, Evolve::TextureData> Evolve::ImageLoader::textureCache_;
+namespace {
+    // the mip chain adds a third to the size of a texture
+    size_t estimateGpuBytes(const Evolve::TextureData& texture) {
+        return (size_t) texture.width * texture.height * texture.bitsPerPixel * 4 / 3;
+    }
+}
+
+Evolve::FlatHashMap<Evolve::StringId, Evolve::ImageLoader::CacheEntry, Evolve::StringIdHash> Evolve::ImageLoader::textureCache_;
+std::list<Evolve::StringId> Evolve::ImageLoader::lru_;
+Evolve::TextureCacheStats Evolve::ImageLoader::cacheStats_;
+size_t Evolve::ImageLoader::cpuBudget_ = 64 * 1024 * 1024;
+size_t Evolve::ImageLoader::gpuBudget_ = 128 * 1024 * 1024;
+std::mutex Evolve::ImageLoader::cacheMutex_;
 
 void Evolve::ImageLoader::LoadTextureFromImage(const std::string& imagePath, TextureData& texture,
     const unsigned int colorChannels) {
@@ -34,42 +46,91 @@ void Evolve::ImageLoader::LoadTextureFromImage(const std::string& imagePath, Tex
         return;
     }
 
-    auto it = textureCache_.find(imagePath);
+    // release whatever the texture held before
+    FreeTexture(texture);
+    DeleteTexture(texture);
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        CacheEntry* cachedEntry = textureCache_.find(StringId(imagePath.c_str()));
+
+        if (cachedEntry != nullptr && cachedEntry->Texture.data != nullptr) { // Found in the cache
+            CacheEntry& entry = *cachedEntry;
 
-    if (it != textureCache_.end()) { // Found in the cache
-        texture = it->second;
-        //printf("Loaded from cache.\n\n");
+            texture = entry.Texture;
+            texture.id = 0;
+
+            entry.CpuRefs++;
+            touchEntry(entry);
+
+            cacheStats_.Hits++;
+            return;
+        }
+
+        cacheStats_.Misses++;
     }
-    else { // Not found in the cache
 
-        FreeTexture(texture);
-        DeleteTexture(texture);
+    // Not found in the cache, decode without holding the lock so other threads can load meanwhile
 
-        texture.path = imagePath;
-        texture.bitsPerPixel = colorChannels;
+    texture.path = imagePath;
+    texture.bitsPerPixel = colorChannels;
+    texture.format = TexturePixelFormat::BYTE_PER_CHANNEL;
+    texture.premultipliedAlpha = false;
 
-        texture.data =
-            stbi_load(
-                imagePath.c_str(),
-                &texture.width,
-                &texture.height,
-                &texture.bitsPerPixelInFile,
-                texture.bitsPerPixel
-            );
+    texture.data =
+        stbi_load(
+            imagePath.c_str(),
+            &texture.width,
+            &texture.height,
+            &texture.bitsPerPixelInFile,
+            texture.bitsPerPixel
+        );
 
-        if (texture.data == nullptr) {
-            std::string errStr = "Failed to load image at " + imagePath;
+    if (texture.data == nullptr) {
+        std::string errStr = "Failed to load image at " + imagePath;
 
-            EVOLVE_REPORT_ERROR(errStr.c_str(), LoadTextureFromImage);
+        EVOLVE_REPORT_ERROR(errStr.c_str(), LoadTextureFromImage);
 
-            texture.path = "";
-            texture.bitsPerPixel = 0;
-        }
-        else {
-            textureCache_.insert(make_pair(imagePath, texture));
-            //printf("Loaded from file.\n\n");
-        }
-    }    
+        texture.path = "";
+        texture.bitsPerPixel = 0;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    // the key must keep its string, the path only lives for this call
+    StringId pathId = StringId::intern(imagePath);
+
+    auto inserted = textureCache_.tryEmplace(pathId);
+    CacheEntry& entry = *inserted.first;
+
+    if (inserted.second) {
+        lru_.push_front(pathId);
+        entry.LruPosition = lru_.begin();
+    }
+
+    if (entry.Texture.data != nullptr) {
+        // another thread decoded the same image meanwhile, use its copy
+        stbi_image_free(texture.data);
+        texture = entry.Texture;
+        texture.id = 0;
+    }
+    else {
+        // a new entry, or one whose pixels were evicted while its gl texture stayed
+        GLuint cachedID = entry.Texture.id;
+
+        entry.Texture = texture;
+        entry.Texture.id = cachedID;
+
+        entry.CpuBytes = (size_t) texture.width * texture.height * texture.bitsPerPixel;
+        cacheStats_.ResidentCpuBytes += entry.CpuBytes;
+    }
+
+    entry.CpuRefs++;
+    touchEntry(entry);
+
+    evictPixels();
 }
 
 void Evolve::ImageLoader::BufferTextureData(TextureData& texture) {
@@ -79,32 +140,328 @@ void Evolve::ImageLoader::BufferTextureData(TextureData& texture) {
         return;
     }
 
+    if (!texture.path.empty()) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        CacheEntry* cachedEntry = textureCache_.find(StringId(texture.path.c_str()));
+
+        if (cachedEntry != nullptr && cachedEntry->Texture.id != 0) {
+            CacheEntry& entry = *cachedEntry;
+
+            texture.id = entry.Texture.id;
+
+            entry.GpuRefs++;
+            touchEntry(entry);
+
+            cacheStats_.Hits++;
+            return;
+        }
+    }
+
     if (texture.data == nullptr) {
         EVOLVE_REPORT_ERROR("Texture has no pixel data.", BufferTextureData);
         return;
     }
 
+    uploadTexture(texture);
+
+    if (texture.path.empty()) {
+        return;
+    }
+
+    std::vector<GLuint> texturesToDelete;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        CacheEntry* cachedEntry = textureCache_.find(StringId(texture.path.c_str()));
+
+        // textures of images that aren't cached belong to the caller
+        if (cachedEntry == nullptr) {
+            return;
+        }
+
+        CacheEntry& entry = *cachedEntry;
+
+        entry.Texture.id = texture.id;
+        entry.GpuRefs++;
+        entry.GpuBytes = estimateGpuBytes(texture);
+
+        cacheStats_.ResidentGpuBytes += entry.GpuBytes;
+        cacheStats_.Misses++;
+
+        evictTextures(texturesToDelete);
+    }
+
+    if (!texturesToDelete.empty()) {
+        glDeleteTextures((GLsizei) texturesToDelete.size(), texturesToDelete.data());
+    }
+}
+
+void Evolve::ImageLoader::ConvertTexture(TextureData& texture, const ImageConversion& conversion) {
+
+    if (texture.data == nullptr) {
+        EVOLVE_REPORT_ERROR("Texture has no pixel data.", ConvertTexture);
+        return;
+    }
+
+    if (texture.id != 0) {
+        EVOLVE_REPORT_ERROR("Texture data is already buffered.", ConvertTexture);
+        return;
+    }
+
+    if (texture.bitsPerPixel != 4 || texture.format != TexturePixelFormat::BYTE_PER_CHANNEL) {
+        EVOLVE_REPORT_ERROR("Only rgba textures with a byte per channel can be converted.", ConvertTexture);
+        return;
+    }
+
+    bool packs = conversion.Format != TexturePixelFormat::BYTE_PER_CHANNEL;
+
+    if (!conversion.Swizzle && !conversion.PremultiplyAlpha && !packs) {
+        return;
+    }
+
+    size_t numPixels = (size_t) texture.width * texture.height;
+
+    // stbi_image_free frees with free, so the converted pixels are allocated with malloc
+    if (!texture.path.empty()) {
+        // the pixels may be shared through the cache, convert a copy
+        unsigned char* pixels = (unsigned char*) malloc(numPixels * 4);
+
+        if (pixels == nullptr) {
+            EVOLVE_REPORT_ERROR("Failed to allocate the converted pixels.", ConvertTexture);
+            return;
+        }
+
+        memcpy(pixels, texture.data, numPixels * 4);
+
+        FreeTexture(texture);
+
+        texture.data = pixels;
+        texture.path = "";
+    }
+
+    if (conversion.Swizzle) {
+        PixelConverter::SwizzleChannels(texture.data, numPixels, conversion.SwizzleOrder);
+    }
+
+    if (conversion.PremultiplyAlpha && !texture.premultipliedAlpha) {
+        PixelConverter::PremultiplyAlpha(texture.data, numPixels);
+        texture.premultipliedAlpha = true;
+    }
+
+    if (!packs) {
+        return;
+    }
+
+    uint16_t* packedPixels = (uint16_t*) malloc(numPixels * sizeof(uint16_t));
+
+    if (packedPixels == nullptr) {
+        EVOLVE_REPORT_ERROR("Failed to allocate the converted pixels.", ConvertTexture);
+        return;
+    }
+
+    if (conversion.Format == TexturePixelFormat::RGB565) {
+        PixelConverter::PackRgb565(texture.data, packedPixels, numPixels);
+    }
+    else {
+        PixelConverter::PackRgba4444(texture.data, packedPixels, numPixels);
+    }
+
+    free(texture.data);
+
+    texture.data = (unsigned char*) packedPixels;
+    texture.bitsPerPixel = sizeof(uint16_t);
+    texture.format = conversion.Format;
+}
+
+void Evolve::ImageLoader::FreeTexture(TextureData& texture) {
+    if (texture.data == nullptr) {
+        return;
+    }
+
+    if (!texture.path.empty()) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+
+        CacheEntry* cachedEntry = textureCache_.find(StringId(texture.path.c_str()));
+
+        // cached pixels are only released, they're freed when evicted
+        if (cachedEntry != nullptr && cachedEntry->Texture.data == texture.data) {
+            if (cachedEntry->CpuRefs > 0) {
+                cachedEntry->CpuRefs--;
+            }
+
+            texture.data = nullptr;
+
+            evictPixels();
+            return;
+        }
+    }
+
+    stbi_image_free(texture.data);
+    texture.data = nullptr;
+}
+
+void Evolve::ImageLoader::DeleteTexture(TextureData& texture) {
+    if (texture.id == 0) {
+        return;
+    }
+
+    if (!texture.path.empty()) {
+        std::vector<GLuint> texturesToDelete;
+
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+
+            CacheEntry* cachedEntry = textureCache_.find(StringId(texture.path.c_str()));
+
+            // cached textures are only released, they're deleted when evicted
+            if (cachedEntry != nullptr && cachedEntry->Texture.id == texture.id) {
+                if (cachedEntry->GpuRefs > 0) {
+                    cachedEntry->GpuRefs--;
+                }
+
+                texture.id = 0;
+
+                evictTextures(texturesToDelete);
+            }
+        }
+
+        if (!texturesToDelete.empty()) {
+            glDeleteTextures((GLsizei) texturesToDelete.size(), texturesToDelete.data());
+        }
+
+        if (texture.id == 0) {
+            return;
+        }
+    }
+
+    glDeleteTextures(1, &texture.id);
+    texture.id = 0;
+}
+
+void Evolve::ImageLoader::SetCacheBudgets(const size_t cpuBytes, const size_t gpuBytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    cpuBudget_ = cpuBytes;
+    gpuBudget_ = gpuBytes;
+
+    // the textures wait for the next buffer or delete, which happens on the gl thread
+    evictPixels();
+}
+
+Evolve::TextureCacheStats Evolve::ImageLoader::GetCacheStats() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    TextureCacheStats stats = cacheStats_;
+    stats.NumEntries = textureCache_.size();
+
+    return stats;
+}
+
+void Evolve::ImageLoader::touchEntry(CacheEntry& entry) {
+    lru_.splice(lru_.begin(), lru_, entry.LruPosition);
+}
+
+void Evolve::ImageLoader::evictPixels() {
+    // walk from the least recently used entry, skipping the referenced ones
+    for (auto it = lru_.end(); it != lru_.begin() && cacheStats_.ResidentCpuBytes > cpuBudget_;) {
+        --it;
+
+        CacheEntry& entry = textureCache_[*it];
+
+        if (entry.Texture.data == nullptr || entry.CpuRefs > 0) {
+            continue;
+        }
+
+        stbi_image_free(entry.Texture.data);
+        entry.Texture.data = nullptr;
+
+        cacheStats_.ResidentCpuBytes -= entry.CpuBytes;
+        entry.CpuBytes = 0;
+        cacheStats_.Evictions++;
+
+        // the iterator is moved first as removing the entry erases its lru node
+        StringId pathId = *it++;
+        removeEntryIfEmpty(pathId);
+    }
+}
+
+void Evolve::ImageLoader::evictTextures(std::vector<GLuint>& texturesToDelete) {
+    for (auto it = lru_.end(); it != lru_.begin() && cacheStats_.ResidentGpuBytes > gpuBudget_;) {
+        --it;
+
+        CacheEntry& entry = textureCache_[*it];
+
+        if (entry.Texture.id == 0 || entry.GpuRefs > 0) {
+            continue;
+        }
+
+        texturesToDelete.push_back(entry.Texture.id);
+        entry.Texture.id = 0;
+
+        cacheStats_.ResidentGpuBytes -= entry.GpuBytes;
+        entry.GpuBytes = 0;
+        cacheStats_.Evictions++;
+
+        StringId pathId = *it++;
+        removeEntryIfEmpty(pathId);
+    }
+}
+
+void Evolve::ImageLoader::removeEntryIfEmpty(const StringId& pathId) {
+    CacheEntry* entry = textureCache_.find(pathId);
+
+    if (entry != nullptr && entry->Texture.data == nullptr && entry->Texture.id == 0) {
+        lru_.erase(entry->LruPosition);
+        textureCache_.erase(pathId);
+    }
+}
+
+void Evolve::ImageLoader::uploadTexture(TextureData& texture) {
     glGenTextures(1, &texture.id);
 
     glBindTexture(GL_TEXTURE_2D, texture.id);
 
     GLint internalFormat = 0;
     GLenum pixelFormat = 0;
+    GLenum pixelType = GL_UNSIGNED_BYTE;
 
-    switch (texture.bitsPerPixel) {
-    case 1:
-        internalFormat = GL_RED;
-        pixelFormat = GL_RED;
+    switch (texture.format) {
+    case TexturePixelFormat::RGB565:
+        internalFormat = GL_RGB5;
+        pixelFormat = GL_RGB;
+        pixelType = GL_UNSIGNED_SHORT_5_6_5;
         break;
 
-    case 4:
-        internalFormat = GL_RGBA8;
+    case TexturePixelFormat::RGBA4444:
+        internalFormat = GL_RGBA4;
         pixelFormat = GL_RGBA;
+        pixelType = GL_UNSIGNED_SHORT_4_4_4_4;
+        break;
+
+    case TexturePixelFormat::BYTE_PER_CHANNEL:
+        switch (texture.bitsPerPixel) {
+        case 1:
+            internalFormat = GL_RED;
+            pixelFormat = GL_RED;
+            break;
+
+        case 4:
+            internalFormat = GL_RGBA8;
+            pixelFormat = GL_RGBA;
+            break;
+        }
         break;
     }
 
+    // rows of one or two byte pixels aren't always 4 byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, texture.width, texture.height,
-        0, pixelFormat, GL_UNSIGNED_BYTE, &texture.data[0]);
+        0, pixelFormat, pixelType, &texture.data[0]);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
 
     if (internalFormat == GL_RED && pixelFormat == GL_RED) {
@@ -121,18 +478,4 @@ void Evolve::ImageLoader::BufferTextureData(TextureData& texture) {
     glGenerateMipmap(GL_TEXTURE_2D);
 
     glBindTexture(GL_TEXTURE_2D, 0);
-}
-
-void Evolve::ImageLoader::FreeTexture(TextureData& texture) {
-    if (texture.data != nullptr) {
-        stbi_image_free(texture.data);
-        texture.data = nullptr;
-    }
-}
-
-void Evolve::ImageLoader::DeleteTexture(TextureData& texture) {
-    if (texture.id != 0) {
-        glDeleteTextures(1, &texture.id);
-        texture.id = 0;
-    }
-}
+}
\ No newline at end of file
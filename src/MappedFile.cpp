@@ -0,0 +1,171 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+Evolve::MappedFile::MappedFile() {}
+
+Evolve::MappedFile::~MappedFile() {
+	closeFile();
+}
+
+bool Evolve::MappedFile::openFile(const std::string& filePath, 
+	const MappedFileAccess access /*= MappedFileAccess::SEQUENTIAL*/) {
+
+	closeFile();
+
+#ifdef _WIN32
+	DWORD accessFlag = 0;
+
+	if (access == MappedFileAccess::SEQUENTIAL) {
+		accessFlag = FILE_FLAG_SEQUENTIAL_SCAN;
+	}
+	else if (access == MappedFileAccess::RANDOM) {
+		accessFlag = FILE_FLAG_RANDOM_ACCESS;
+	}
+
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | accessFlag, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		std::string errStr = "Failed to open " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		std::string errStr = "Failed to get the size of " + filePath + " or it is empty.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping == nullptr) {
+		std::string errStr = "Failed to map " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (view == nullptr) {
+		std::string errStr = "Failed to map " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle_ = file;
+	mappingHandle_ = mapping;
+	data_ = (const unsigned char*) view;
+	size_ = (size_t) fileSize.QuadPart;
+#else
+	int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+
+	if (fileDescriptor == -1) {
+		std::string errStr = "Failed to open " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		return false;
+	}
+
+	struct stat fileStat;
+
+	if (fstat(fileDescriptor, &fileStat) == -1 || fileStat.st_size == 0) {
+		std::string errStr = "Failed to get the size of " + filePath + " or it is empty.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		close(fileDescriptor);
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	if (view == MAP_FAILED) {
+		std::string errStr = "Failed to map " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), openFile);
+		close(fileDescriptor);
+		return false;
+	}
+
+	int advice = MADV_NORMAL;
+
+	if (access == MappedFileAccess::SEQUENTIAL) {
+		advice = MADV_SEQUENTIAL;
+	}
+	else if (access == MappedFileAccess::RANDOM) {
+		advice = MADV_RANDOM;
+	}
+
+	madvise(view, (size_t) fileStat.st_size, advice);
+
+	fileDescriptor_ = fileDescriptor;
+	data_ = (const unsigned char*) view;
+	size_ = (size_t) fileStat.st_size;
+#endif
+
+	return true;
+}
+
+void Evolve::MappedFile::closeFile() {
+#ifdef _WIN32
+	if (data_ != nullptr) {
+		UnmapViewOfFile(data_);
+	}
+
+	if (mappingHandle_ != nullptr) {
+		CloseHandle(mappingHandle_);
+		mappingHandle_ = nullptr;
+	}
+
+	if (fileHandle_ != nullptr) {
+		CloseHandle(fileHandle_);
+		fileHandle_ = nullptr;
+	}
+#else
+	if (data_ != nullptr) {
+		munmap((void*) data_, size_);
+	}
+
+	if (fileDescriptor_ != -1) {
+		close(fileDescriptor_);
+		fileDescriptor_ = -1;
+	}
+#endif
+
+	data_ = nullptr;
+	size_ = 0;
+}
\ No newline at end of file
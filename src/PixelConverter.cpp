@@ -0,0 +1,357 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/PixelConverter.h"
+
+#if defined(__AVX2__)
+#define EVOLVE_PIXELS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EVOLVE_PIXELS_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define EVOLVE_PIXELS_NEON
+#include <arm_neon.h>
+#endif
+
+// the scalar versions finish the pixels left over by the vector loops and define the expected results
+
+namespace {
+	// x / 255 rounded to the nearest, exact for every x up to 255 * 255
+	inline unsigned char divideBy255(const unsigned int x) {
+		unsigned int rounded = x + 128;
+		return (unsigned char) ((rounded + (rounded >> 8)) >> 8);
+	}
+
+	void premultiplyScalar(unsigned char* pixels, size_t begin, const size_t end) {
+		for (; begin < end; begin++) {
+			unsigned char* pixel = pixels + begin * 4;
+			unsigned int alpha = pixel[3];
+
+			pixel[0] = divideBy255(pixel[0] * alpha);
+			pixel[1] = divideBy255(pixel[1] * alpha);
+			pixel[2] = divideBy255(pixel[2] * alpha);
+		}
+	}
+
+	void packRgb565Scalar(const unsigned char* pixels, uint16_t* packed, size_t begin, const size_t end) {
+		for (; begin < end; begin++) {
+			const unsigned char* pixel = pixels + begin * 4;
+
+			packed[begin] = (uint16_t) (((pixel[0] >> 3) << 11) | ((pixel[1] >> 2) << 5) | (pixel[2] >> 3));
+		}
+	}
+
+	void packRgba4444Scalar(const unsigned char* pixels, uint16_t* packed, size_t begin, const size_t end) {
+		for (; begin < end; begin++) {
+			const unsigned char* pixel = pixels + begin * 4;
+
+			packed[begin] = (uint16_t) (((pixel[0] >> 4) << 12) | ((pixel[1] >> 4) << 8) | 
+				((pixel[2] >> 4) << 4) | (pixel[3] >> 4));
+		}
+	}
+
+	void swizzleScalar(unsigned char* pixels, size_t begin, const size_t end, const unsigned char order[4]) {
+		for (; begin < end; begin++) {
+			unsigned char* pixel = pixels + begin * 4;
+			unsigned char old[4] = { pixel[0], pixel[1], pixel[2], pixel[3] };
+
+			pixel[0] = old[order[0]];
+			pixel[1] = old[order[1]];
+			pixel[2] = old[order[2]];
+			pixel[3] = old[order[3]];
+		}
+	}
+
+#if defined(EVOLVE_PIXELS_AVX2) || defined(EVOLVE_PIXELS_SSE2)
+
+	// the same rounding as divideBy255 on 16 bit lanes
+	inline __m128i divideBy255(const __m128i x) {
+		__m128i rounded = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+	}
+
+	// 16 bit lanes of two pixels, the alpha lanes multiply by 255 so they come out unchanged
+	inline __m128i premultiplyTwoPixels(const __m128i pixels) {
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		alpha = _mm_or_si128(alpha, _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+
+		return divideBy255(_mm_mullo_epi16(pixels, alpha));
+	}
+
+	// 32 bit lanes of four pixels
+	inline __m128i packRgb565(const __m128i pixels) {
+		__m128i mask = _mm_set1_epi32(0xFF);
+
+		__m128i red = _mm_and_si128(pixels, mask);
+		__m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+		__m128i blue = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+
+		return _mm_or_si128(_mm_or_si128(
+			_mm_slli_epi32(_mm_srli_epi32(red, 3), 11),
+			_mm_slli_epi32(_mm_srli_epi32(green, 2), 5)),
+			_mm_srli_epi32(blue, 3));
+	}
+
+	inline __m128i packRgba4444(const __m128i pixels) {
+		__m128i mask = _mm_set1_epi32(0xF0);
+
+		__m128i red = _mm_and_si128(pixels, mask);
+		__m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+		__m128i blue = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+		__m128i alpha = _mm_srli_epi32(pixels, 28);
+
+		return _mm_or_si128(
+			_mm_or_si128(_mm_slli_epi32(red, 8), _mm_slli_epi32(green, 4)),
+			_mm_or_si128(blue, alpha));
+	}
+
+	// packs two vectors of 32 bit lanes below 0x10000 into 16 bit lanes,
+	// sse2 only packs with signed saturation so the lanes are shifted into the signed range and back
+	inline __m128i packUnsigned32To16(const __m128i low, const __m128i high) {
+		__m128i bias32 = _mm_set1_epi32(0x8000);
+		__m128i bias16 = _mm_set1_epi16((short) 0x8000);
+
+		return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(low, bias32), _mm_sub_epi32(high, bias32)), bias16);
+	}
+
+#endif
+}
+
+void Evolve::PixelConverter::PremultiplyAlpha(unsigned char* rgbaPixels, const size_t numPixels) {
+	size_t i = 0;
+
+#if defined(EVOLVE_PIXELS_AVX2)
+	__m256i zero = _mm256_setzero_si256();
+	__m256i alphaLanes = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+	__m256i roundBias = _mm256_set1_epi16(128);
+
+	for (; i + 8 <= numPixels; i += 8) {
+		__m256i pixels = _mm256_loadu_si256((const __m256i*) (rgbaPixels + i * 4));
+
+		// unpacking and packing both work within the 128 bit halves, so the pixel order is kept
+		__m256i low = _mm256_unpacklo_epi8(pixels, zero);
+		__m256i high = _mm256_unpackhi_epi8(pixels, zero);
+
+		__m256i lowAlpha = _mm256_or_si256(alphaLanes,
+			_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		__m256i highAlpha = _mm256_or_si256(alphaLanes,
+			_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+
+		low = _mm256_add_epi16(_mm256_mullo_epi16(low, lowAlpha), roundBias);
+		high = _mm256_add_epi16(_mm256_mullo_epi16(high, highAlpha), roundBias);
+
+		low = _mm256_srli_epi16(_mm256_add_epi16(low, _mm256_srli_epi16(low, 8)), 8);
+		high = _mm256_srli_epi16(_mm256_add_epi16(high, _mm256_srli_epi16(high, 8)), 8);
+
+		_mm256_storeu_si256((__m256i*) (rgbaPixels + i * 4), _mm256_packus_epi16(low, high));
+	}
+
+#elif defined(EVOLVE_PIXELS_SSE2)
+	__m128i zero = _mm_setzero_si128();
+
+	for (; i + 4 <= numPixels; i += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4));
+
+		__m128i low = premultiplyTwoPixels(_mm_unpacklo_epi8(pixels, zero));
+		__m128i high = premultiplyTwoPixels(_mm_unpackhi_epi8(pixels, zero));
+
+		_mm_storeu_si128((__m128i*) (rgbaPixels + i * 4), _mm_packus_epi16(low, high));
+	}
+
+#elif defined(EVOLVE_PIXELS_NEON)
+	for (; i + 8 <= numPixels; i += 8) {
+		uint8x8x4_t pixels = vld4_u8(rgbaPixels + i * 4);
+
+		for (int channel = 0; channel < 3; channel++) {
+			uint16x8_t product = vmull_u8(pixels.val[channel], pixels.val[3]);
+
+			// (x + ((x + 128) >> 8) + 128) >> 8, the same rounding as divideBy255
+			pixels.val[channel] = vrshrn_n_u16(vrsraq_n_u16(product, product, 8), 8);
+		}
+
+		vst4_u8(rgbaPixels + i * 4, pixels);
+	}
+#endif
+
+	premultiplyScalar(rgbaPixels, i, numPixels);
+}
+
+void Evolve::PixelConverter::PackRgb565(const unsigned char* rgbaPixels, uint16_t* packedPixels, 
+	const size_t numPixels) {
+
+	size_t i = 0;
+
+#if defined(EVOLVE_PIXELS_AVX2)
+	for (; i + 16 <= numPixels; i += 16) {
+		__m256i first = _mm256_loadu_si256((const __m256i*) (rgbaPixels + i * 4));
+		__m256i second = _mm256_loadu_si256((const __m256i*) (rgbaPixels + i * 4 + 32));
+
+		__m128i packed[4] = {
+			packRgb565(_mm256_castsi256_si128(first)), packRgb565(_mm256_extracti128_si256(first, 1)),
+			packRgb565(_mm256_castsi256_si128(second)), packRgb565(_mm256_extracti128_si256(second, 1))
+		};
+
+		_mm_storeu_si128((__m128i*) (packedPixels + i), packUnsigned32To16(packed[0], packed[1]));
+		_mm_storeu_si128((__m128i*) (packedPixels + i + 8), packUnsigned32To16(packed[2], packed[3]));
+	}
+
+#elif defined(EVOLVE_PIXELS_SSE2)
+	for (; i + 8 <= numPixels; i += 8) {
+		__m128i first = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4));
+		__m128i second = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4 + 16));
+
+		_mm_storeu_si128((__m128i*) (packedPixels + i), packUnsigned32To16(packRgb565(first), packRgb565(second)));
+	}
+
+#elif defined(EVOLVE_PIXELS_NEON)
+	for (; i + 8 <= numPixels; i += 8) {
+		uint8x8x4_t pixels = vld4_u8(rgbaPixels + i * 4);
+
+		uint16x8_t red = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[0], 3)), 11);
+		uint16x8_t green = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[1], 2)), 5);
+		uint16x8_t blue = vmovl_u8(vshr_n_u8(pixels.val[2], 3));
+
+		vst1q_u16(packedPixels + i, vorrq_u16(vorrq_u16(red, green), blue));
+	}
+#endif
+
+	packRgb565Scalar(rgbaPixels, packedPixels, i, numPixels);
+}
+
+void Evolve::PixelConverter::PackRgba4444(const unsigned char* rgbaPixels, uint16_t* packedPixels,
+	const size_t numPixels) {
+
+	size_t i = 0;
+
+#if defined(EVOLVE_PIXELS_AVX2) || defined(EVOLVE_PIXELS_SSE2)
+	// the packing is bound by the loads and stores, so avx2 uses the sse2 loop
+	for (; i + 8 <= numPixels; i += 8) {
+		__m128i first = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4));
+		__m128i second = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4 + 16));
+
+		_mm_storeu_si128((__m128i*) (packedPixels + i), packUnsigned32To16(packRgba4444(first), packRgba4444(second)));
+	}
+
+#elif defined(EVOLVE_PIXELS_NEON)
+	for (; i + 8 <= numPixels; i += 8) {
+		uint8x8x4_t pixels = vld4_u8(rgbaPixels + i * 4);
+
+		uint16x8_t red = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[0], 4)), 12);
+		uint16x8_t green = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[1], 4)), 8);
+		uint16x8_t blue = vshlq_n_u16(vmovl_u8(vshr_n_u8(pixels.val[2], 4)), 4);
+		uint16x8_t alpha = vmovl_u8(vshr_n_u8(pixels.val[3], 4));
+
+		vst1q_u16(packedPixels + i, vorrq_u16(vorrq_u16(red, green), vorrq_u16(blue, alpha)));
+	}
+#endif
+
+	packRgba4444Scalar(rgbaPixels, packedPixels, i, numPixels);
+}
+
+void Evolve::PixelConverter::SwizzleChannels(unsigned char* rgbaPixels, const size_t numPixels, 
+	const unsigned char order[4]) {
+
+	for (int channel = 0; channel < 4; channel++) {
+		if (order[channel] > 3) {
+			EVOLVE_REPORT_ERROR("Invalid channel in the swizzle order.", SwizzleChannels);
+			return;
+		}
+	}
+
+	size_t i = 0;
+
+#if defined(EVOLVE_PIXELS_AVX2)
+	// the byte shuffle works within the 128 bit halves, each holds four whole pixels
+	char shuffle[32];
+
+	for (int byte = 0; byte < 32; byte++) {
+		shuffle[byte] = (char) ((byte & ~3 & 15) + order[byte & 3]);
+	}
+
+	__m256i mask = _mm256_loadu_si256((const __m256i*) shuffle);
+
+	for (; i + 8 <= numPixels; i += 8) {
+		__m256i pixels = _mm256_loadu_si256((const __m256i*) (rgbaPixels + i * 4));
+		_mm256_storeu_si256((__m256i*) (rgbaPixels + i * 4), _mm256_shuffle_epi8(pixels, mask));
+	}
+
+#elif defined(EVOLVE_PIXELS_SSE2)
+	// sse2 has no byte shuffle, the pixels are split into 16 bit lanes and reordered with word shuffles,
+	// which take their order as an immediate, so only the common orders get a vector loop
+	__m128i zero = _mm_setzero_si128();
+
+	auto swizzleLoop = [&](auto shuffleWords) {
+		for (; i + 4 <= numPixels; i += 4) {
+			__m128i pixels = _mm_loadu_si128((const __m128i*) (rgbaPixels + i * 4));
+
+			__m128i low = shuffleWords(_mm_unpacklo_epi8(pixels, zero));
+			__m128i high = shuffleWords(_mm_unpackhi_epi8(pixels, zero));
+
+			_mm_storeu_si128((__m128i*) (rgbaPixels + i * 4), _mm_packus_epi16(low, high));
+		}
+	};
+
+	if (order[0] == 2 && order[1] == 1 && order[2] == 0 && order[3] == 3) { // bgra <-> rgba
+		swizzleLoop([](__m128i words) {
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+		});
+	}
+	else if (order[0] == 3 && order[1] == 0 && order[2] == 1 && order[3] == 2) { // rgba -> argb
+		swizzleLoop([](__m128i words) {
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, _MM_SHUFFLE(2, 1, 0, 3)), _MM_SHUFFLE(2, 1, 0, 3));
+		});
+	}
+	else if (order[0] == 1 && order[1] == 2 && order[2] == 3 && order[3] == 0) { // argb -> rgba
+		swizzleLoop([](__m128i words) {
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(words, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+		});
+	}
+
+#elif defined(EVOLVE_PIXELS_NEON)
+	for (; i + 8 <= numPixels; i += 8) {
+		uint8x8x4_t pixels = vld4_u8(rgbaPixels + i * 4);
+		uint8x8x4_t swizzled;
+
+		swizzled.val[0] = pixels.val[order[0]];
+		swizzled.val[1] = pixels.val[order[1]];
+		swizzled.val[2] = pixels.val[order[2]];
+		swizzled.val[3] = pixels.val[order[3]];
+
+		vst4_u8(rgbaPixels + i * 4, swizzled);
+	}
+#endif
+
+	swizzleScalar(rgbaPixels, i, numPixels, order);
+}
+
+const char* Evolve::PixelConverter::GetSimdName() {
+#if defined(EVOLVE_PIXELS_AVX2)
+	return "AVX2";
+#elif defined(EVOLVE_PIXELS_SSE2)
+	return "SSE2";
+#elif defined(EVOLVE_PIXELS_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
\ No newline at end of file
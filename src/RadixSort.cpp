@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/RadixSort.h"
+
+void Evolve::radixSortEntries(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch) {
+
+	const size_t NUM_PASSES = 8;
+	const size_t NUM_BUCKETS = 256;
+
+	size_t numEntries = entries.size();
+
+	if (numEntries < 2) {
+		return;
+	}
+
+	// find the bytes that differ between the keys, only those need a pass
+	uint64_t allBitsSet = ~0ull, anyBitSet = 0;
+
+	for (size_t i = 0; i < numEntries; i++) {
+		allBitsSet &= entries[i].Key;
+		anyBitSet |= entries[i].Key;
+	}
+
+	uint64_t differingBits = allBitsSet ^ anyBitSet;
+
+	size_t passes[NUM_PASSES] = {};
+	size_t numPasses = 0;
+
+	for (size_t pass = 0; pass < NUM_PASSES; pass++) {
+		if ((differingBits >> (pass * 8)) & 0xFF) {
+			passes[numPasses++] = pass;
+		}
+	}
+
+	if (numPasses == 0) {
+		return;
+	}
+
+	// build the histograms of all the needed passes in a single read of the keys
+	size_t histograms[NUM_PASSES][NUM_BUCKETS] = {};
+
+	for (size_t i = 0; i < numEntries; i++) {
+		uint64_t key = entries[i].Key;
+
+		for (size_t p = 0; p < numPasses; p++) {
+			histograms[p][(key >> (passes[p] * 8)) & 0xFF]++;
+		}
+	}
+
+	scratch.resize(numEntries);
+
+	SortEntry* source = entries.data();
+	SortEntry* destination = scratch.data();
+
+	for (size_t p = 0; p < numPasses; p++) {
+		size_t* histogram = histograms[p];
+		size_t shift = passes[p] * 8;
+
+		// turn the counts into the starting offset of each bucket
+		size_t offset = 0;
+
+		for (size_t bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+			size_t count = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += count;
+		}
+
+		for (size_t i = 0; i < numEntries; i++) {
+			size_t bucket = (source[i].Key >> shift) & 0xFF;
+			destination[histogram[bucket]++] = source[i];
+		}
+
+		std::swap(source, destination);
+	}
+
+	// the sorted entries ended up in the scratch buffer
+	if (source != entries.data()) {
+		entries.swap(scratch);
+	}
+}
\ No newline at end of file
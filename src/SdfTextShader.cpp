@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/SdfTextShader.h"
+
+namespace {
+	constexpr Evolve::StringId SDF_SPREAD_UNIFORM("u_sdfSpread");
+	constexpr Evolve::StringId OUTLINE_WIDTH_UNIFORM("u_outlineWidth");
+	constexpr Evolve::StringId OUTLINE_COLOR_UNIFORM("u_outlineColor");
+	constexpr Evolve::StringId SHADOW_OFFSET_UNIFORM("u_shadowOffset");
+	constexpr Evolve::StringId SHADOW_SOFTNESS_UNIFORM("u_shadowSoftness");
+	constexpr Evolve::StringId SHADOW_COLOR_UNIFORM("u_shadowColor");
+
+	void sendColor(GLint location, const Evolve::ColorRgba& color) {
+		glUniform4f(location, color.Red / 255.0f, color.Green / 255.0f, color.Blue / 255.0f, color.Alpha / 255.0f);
+	}
+}
+
+Evolve::SdfTextShader::SdfTextShader() {}
+
+Evolve::SdfTextShader::~SdfTextShader() {
+	freeSdfTextShader();
+}
+
+bool Evolve::SdfTextShader::init(const std::string& pathToAssets) {
+	
+	// the vertices are the same as for any texture, only the fragments differ
+	if (!program_.compileAndLinkShaders(
+		pathToAssets + "/shaders/texture_shader.vert",
+		pathToAssets + "/shaders/sdf_text_shader.frag")) {
+		EVOLVE_REPORT_ERROR("Failed to compile or link sdf text shader.", init);
+		return false;
+	}
+
+	inited_ = true;
+	styleChanged_ = true;
+
+	return true;
+}
+
+void Evolve::SdfTextShader::setOutline(const ColorRgba& color, const float width) {
+	outlineColor_ = color;
+	outlineWidth_ = std::max(width, 0.0f);
+
+	styleChanged_ = true;
+}
+
+void Evolve::SdfTextShader::setShadow(const ColorRgba& color, const float offsetX, const float offsetY, 
+	const float softness /*= 0.0f*/) {
+
+	shadowColor_ = color;
+	shadowOffsetX_ = offsetX;
+	shadowOffsetY_ = offsetY;
+	shadowSoftness_ = std::max(softness, 0.0f);
+
+	styleChanged_ = true;
+}
+
+void Evolve::SdfTextShader::clearStyle() {
+	outlineWidth_ = 0.0f;
+	shadowColor_.Alpha = 0;
+
+	styleChanged_ = true;
+}
+
+Evolve::GlslProgram* Evolve::SdfTextShader::getProgram() {
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Sdf text shader not initialized.", getProgram);
+		return nullptr;
+	}
+
+	if (styleChanged_) {
+		sendStyle();
+		styleChanged_ = false;
+	}
+
+	return &program_;
+}
+
+void Evolve::SdfTextShader::freeSdfTextShader() {
+	if (inited_) {
+		program_.freeProgram();
+		inited_ = false;
+	}
+}
+
+void Evolve::SdfTextShader::sendStyle() {
+	// uniforms keep their values in the program, so they're only sent when the style changes
+	program_.useProgram();
+
+	glUniform1f(program_.getUniformLocation(SDF_SPREAD_UNIFORM), (float) FontFaceCache::SDF_SPREAD);
+
+	glUniform1f(program_.getUniformLocation(OUTLINE_WIDTH_UNIFORM), outlineWidth_);
+	sendColor(program_.getUniformLocation(OUTLINE_COLOR_UNIFORM), outlineColor_);
+
+	glUniform2f(program_.getUniformLocation(SHADOW_OFFSET_UNIFORM), shadowOffsetX_, shadowOffsetY_);
+	glUniform1f(program_.getUniformLocation(SHADOW_SOFTNESS_UNIFORM), shadowSoftness_);
+	sendColor(program_.getUniformLocation(SHADOW_COLOR_UNIFORM), shadowColor_);
+
+	program_.unuseProgram();
+}
\ No newline at end of file
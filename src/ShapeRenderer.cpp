@@ -22,12 +22,28 @@ SOFTWARE.
 
 #include "../include/Evolve/ShapeRenderer.h"
 
-Evolve::ShapeRenderer::Shape::Shape(int depth, std::vector<Vertex2D> vertices, 
-	const unsigned int numVertices, const unsigned int numIndices) :
-	depth_(depth), vertices_(vertices), numVertices_(numVertices), numIndices_(numIndices)
-{}
+namespace {
+	const GLuint TRIANGLE_INDICES[3] = { 0, 1, 2 };
+
+	// bottom left, bottom right, top right and bottom left, top left, top right
+	const GLuint QUAD_INDICES[6] = { 0, 1, 2, 0, 3, 2 };
+
+	// pixels added around a smooth shape's quad so its anti-aliased edge isn't clipped
+	const float SDF_QUAD_PADDING = 1.0f;
+
+	const unsigned int MIN_CIRCLE_SEGMENTS = 8;
+	const unsigned int MAX_CIRCLE_SEGMENTS = 512;
+
+	// segment counts are rounded up to a multiple of this to bound the number of circle tables
+	const unsigned int CIRCLE_SEGMENTS_STEP = 4;
+
+	// a polyline join is beveled when its miter would be longer than this many half thicknesses
+	const float MITER_LIMIT = 4.0f;
 
-Evolve::ShapeRenderer::Shape::~Shape() {}
+	long long crossProduct(const Evolve::Position2D& origin, const Evolve::Position2D& a, const Evolve::Position2D& b) {
+		return (long long) (a.X - origin.X) * (b.Y - origin.Y) - (long long) (a.Y - origin.Y) * (b.X - origin.X);
+	}
+}
 
 bool Evolve::ShapeRenderer::init(const std::string& pathToAssets) {
 	std::string vertShaderPath = pathToAssets + "/shaders/shape_shader.vert";
@@ -40,6 +56,13 @@ bool Evolve::ShapeRenderer::init(const std::string& pathToAssets) {
 		return false;
 	}
 
+	if (!sdfShader_.compileAndLinkShaders(
+		pathToAssets + "/shaders/sdf_shape_shader.vert",
+		pathToAssets + "/shaders/sdf_shape_shader.frag")) {
+		EVOLVE_REPORT_ERROR("Failed to compile or link sdf shape shader.", init);
+		return false;
+	}
+
 	inited_ = true;
 	return true;
 }
@@ -49,23 +72,20 @@ void Evolve::ShapeRenderer::begin() {
 		createVao();
 	}
 
+	vertexArena_.clear();
+	sdfVertexArena_.clear();
+	indexArena_.clear();
 	shapes_.clear();
-	shapePointers_.clear();
+	sortEntries_.clear();
 	shapeBatches_.clear();
 
-	totalVertices_ = 0;
-	totalIndices_ = 0;
-
-	if (!iboIDs_.empty()) {
-		glDeleteBuffers((GLsizei)iboIDs_.size(), iboIDs_.data());
-		iboIDs_.clear();
-	}
+	stats_.reset();
 }
 
 void Evolve::ShapeRenderer::drawTriangle(const Position2D& originPos, const Position2D& vertexTwoPos, 
 	const Position2D& vertexThreePos, const ColorRgba& verticesColor, int depth /*= 0*/) {
 
-	std::vector<Vertex2D> vertices(3);	
+	Vertex2D* vertices = addShape(depth, 3, TRIANGLE_INDICES, 3);
 
 	vertices[0].setPosition(originPos);
 	vertices[0].setColor(verticesColor);
@@ -75,11 +95,6 @@ void Evolve::ShapeRenderer::drawTriangle(const Position2D& originPos, const Posi
 
 	vertices[2].setPosition(vertexThreePos);
 	vertices[2].setColor(verticesColor);
-
-	shapes_.emplace_back(depth, vertices, 3, 3);
-	
-	totalVertices_ += shapes_.back().numVertices_;
-	totalIndices_ += shapes_.back().numIndices_;
 }
 
 void Evolve::ShapeRenderer::drawTriangle(
@@ -88,7 +103,7 @@ void Evolve::ShapeRenderer::drawTriangle(
 	const Position2D& vertexThreePos, const ColorRgba& vertexThreeColor,
 	int depth /*= 0*/) {
 
-	std::vector<Vertex2D> vertices(3);
+	Vertex2D* vertices = addShape(depth, 3, TRIANGLE_INDICES, 3);
 
 	vertices[0].setPosition(originPos);
 	vertices[0].setColor(originColor);
@@ -98,18 +113,13 @@ void Evolve::ShapeRenderer::drawTriangle(
 
 	vertices[2].setPosition(vertexThreePos);
 	vertices[2].setColor(vertexThreeColor);
-
-	shapes_.emplace_back(depth, vertices, 3, 3);
-
-	totalVertices_ += shapes_.back().numVertices_;
-	totalIndices_ += shapes_.back().numIndices_;
 }
 
 void Evolve::ShapeRenderer::drawRectangle(const Position2D& originPos, const Position2D& vertexTwoPos, 
 	const Position2D& vertexThreePos, const Position2D& vertexFourPos, 
 	const ColorRgba& verticesColor, int depth /*= 0*/) {
 
-	std::vector<Vertex2D> vertices(4);
+	Vertex2D* vertices = addShape(depth, 4, QUAD_INDICES, 6);
 
 	vertices[0].setPosition(originPos);
 	vertices[0].setColor(verticesColor);
@@ -122,11 +132,6 @@ void Evolve::ShapeRenderer::drawRectangle(const Position2D& originPos, const Pos
 
 	vertices[3].setPosition(vertexFourPos);
 	vertices[3].setColor(verticesColor);
-
-	shapes_.emplace_back(depth, vertices, 4, 6);
-
-	totalVertices_ += shapes_.back().numVertices_;
-	totalIndices_ += shapes_.back().numIndices_;
 }
 
 void Evolve::ShapeRenderer::drawRectangle(const Position2D& originPos, const ColorRgba& originColor,
@@ -135,7 +140,7 @@ void Evolve::ShapeRenderer::drawRectangle(const Position2D& originPos, const Col
 	const Position2D& vertexFourPos, const ColorRgba& vertexFourColor,
 	int depth /*= 0*/) {
 
-	std::vector<Vertex2D> vertices(4);
+	Vertex2D* vertices = addShape(depth, 4, QUAD_INDICES, 6);
 
 	vertices[0].setPosition(originPos);
 	vertices[0].setColor(originColor);
@@ -148,17 +153,12 @@ void Evolve::ShapeRenderer::drawRectangle(const Position2D& originPos, const Col
 
 	vertices[3].setPosition(vertexFourPos);
 	vertices[3].setColor(vertexFourColor);
-
-	shapes_.emplace_back(depth, vertices, 4, 6);
-
-	totalVertices_ += shapes_.back().numVertices_;
-	totalIndices_ += shapes_.back().numIndices_;
 }
 
 void Evolve::ShapeRenderer::drawRectangle(const RectDimension& destRect,
 	const ColorRgba& verticesColor, int depth /*= 0*/) {
 
-	std::vector<Vertex2D> vertices(4);
+	Vertex2D* vertices = addShape(depth, 4, QUAD_INDICES, 6);
 	
 	// bottom left
 	vertices[0].setPosition(destRect.getLeft(), destRect.getBottom());
@@ -175,68 +175,342 @@ void Evolve::ShapeRenderer::drawRectangle(const RectDimension& destRect,
 	// top left
 	vertices[3].setPosition(destRect.getLeft(), destRect.getTop());
 	vertices[3].setColor(verticesColor);
-
-	shapes_.emplace_back(depth, vertices, 4, 6);
-
-	totalVertices_ += shapes_.back().numVertices_;
-	totalIndices_ += shapes_.back().numIndices_;
 }
 
 void Evolve::ShapeRenderer::drawCircle(const Position2D& centerPos, unsigned int radius, 
 	const ColorRgba& color, int depth) {
 	
-	static const int NUM_TRIANGLES = 60;
+	unsigned int numSegments = getCircleSegments((float) radius);
+	const CircleTable& table = getCircleTable(numSegments);
+
+	Vertex2D* vertices = addShape(depth, numSegments + 1, 
+		table.FanIndices.data(), (unsigned int) table.FanIndices.size());
+
+	vertices[0].setPosition(centerPos);
+	vertices[0].setColor(color);
+
+	for (unsigned int i = 0; i < numSegments; i++) {
+		Vertex2D& vertex = vertices[i + 1];
+		vertex.setPosition(
+			centerPos.X + (GLint) std::lround(table.Points[i * 2] * radius),
+			centerPos.Y + (GLint) std::lround(table.Points[i * 2 + 1] * radius)
+		);
+		vertex.setColor(color);
+	}
+}
+
+void Evolve::ShapeRenderer::drawPolyline(const Position2D* points, size_t numPoints, float thickness,
+	const ColorRgba& color, int depth /*= 0*/) {
+	
+	if (numPoints < 2) {
+		return;
+	}
+
+	float halfThickness = thickness / 2.0f;
+	unsigned int numSegments = (unsigned int) numPoints - 1;
+
+	// at most 3 vertices per point when beveled, a quad per segment and a bevel triangle per join
+	GLuint* indices = nullptr;
+	Vertex2D* vertices = reserveShape(depth, (unsigned int) numPoints * 3, 
+		numSegments * 6 + (numSegments - 1) * 3, indices);
+
+	unsigned int numVertices = 0;
+	unsigned int numIndices = 0;
+
+	auto addVertex = [&](float x, float y) {
+		vertices[numVertices].setPosition((GLint) std::lround(x), (GLint) std::lround(y));
+		vertices[numVertices].setColor(color);
+		return numVertices++;
+	};
+
+	// direction of the segment from point i to i + 1, a zero length segment keeps the previous direction
+	float dirX = 1.0f, dirY = 0.0f;
+	auto segmentDirection = [&](size_t i) {
+		float x = (float) (points[i + 1].X - points[i].X);
+		float y = (float) (points[i + 1].Y - points[i].Y);
+		float length = std::sqrt(x * x + y * y);
+
+		if (length > 0.0f) {
+			dirX = x / length;
+			dirY = y / length;
+		}
+	};
+
+	// the left and right vertices where the previous segment ends
+	GLuint prevLeft = 0, prevRight = 0;
+
+	segmentDirection(0);
 
-	Position2D vertexTwoPos { 0, 0 };
-	bool makeTriangle = false;
+	for (size_t i = 0; i < numPoints; i++) {
+		float pointX = (float) points[i].X;
+		float pointY = (float) points[i].Y;
+
+		// the left normal of the incoming segment
+		float inNormalX = -dirY, inNormalY = dirX;
+
+		if (i + 1 < numPoints && i > 0) {
+			segmentDirection(i);
+		}
 
-	for (size_t i = 0; i <= NUM_TRIANGLES; i++) {
+		float outNormalX = -dirY, outNormalY = dirX;
 
-		double angle = (M_PI * 2.0f) * ((float)i / (float)NUM_TRIANGLES);
+		GLuint inLeft, inRight, outLeft, outRight;
 
-		if (!makeTriangle) {
-			vertexTwoPos.X = (GLint) (centerPos.X + cos(angle) * radius);
-			vertexTwoPos.X = (GLint) (centerPos.Y + sin(angle) * radius);
+		float miterX = inNormalX + outNormalX;
+		float miterY = inNormalY + outNormalY;
+		float miterLengthSquared = miterX * miterX + miterY * miterY;
 
-			makeTriangle = true;
+		if (i == 0 || i + 1 == numPoints) {
+			// ends are cut square
+			inLeft = outLeft = addVertex(pointX + outNormalX * halfThickness, pointY + outNormalY * halfThickness);
+			inRight = outRight = addVertex(pointX - outNormalX * halfThickness, pointY - outNormalY * halfThickness);
 		}
 		else {
-			Position2D vertexThreePos {
-				(GLint) (centerPos.X + cos(angle) * radius),
-				(GLint) (centerPos.Y + sin(angle) * radius)
-			};
+			// the miter bisects the normals, its length reaches the offset edges of both segments
+			float cosHalfAngle = 0.0f;
+			float miterLength = 0.0f;
+
+			if (miterLengthSquared > 1e-6f) {
+				float invLength = 1.0f / std::sqrt(miterLengthSquared);
+				miterX *= invLength;
+				miterY *= invLength;
+				cosHalfAngle = miterX * inNormalX + miterY * inNormalY;
+				miterLength = halfThickness / cosHalfAngle;
+			}
+
+			if (cosHalfAngle * MITER_LIMIT >= 1.0f) {
+				inLeft = outLeft = addVertex(pointX + miterX * miterLength, pointY + miterY * miterLength);
+				inRight = outRight = addVertex(pointX - miterX * miterLength, pointY - miterY * miterLength);
+			}
+			else {
+				// the outer side is the one the path turns away from
+				float turn = inNormalX * outNormalY - inNormalY * outNormalX;
+				float side = turn > 0.0f ? -1.0f : 1.0f;
+
+				// a path folding back on itself has no miter, the inner vertex collapses to the point
+				float innerLength = miterLengthSquared > 1e-6f ? std::min(miterLength, halfThickness * MITER_LIMIT) : 0.0f;
+
+				GLuint inner = addVertex(pointX - side * miterX * innerLength, pointY - side * miterY * innerLength);
+				GLuint outerIn = addVertex(pointX + side * inNormalX * halfThickness, pointY + side * inNormalY * halfThickness);
+				GLuint outerOut = addVertex(pointX + side * outNormalX * halfThickness, pointY + side * outNormalY * halfThickness);
+
+				if (side > 0.0f) {
+					inLeft = outerIn;
+					outLeft = outerOut;
+					inRight = outRight = inner;
+				}
+				else {
+					inRight = outerIn;
+					outRight = outerOut;
+					inLeft = outLeft = inner;
+				}
 
-			drawTriangle(centerPos, vertexTwoPos, vertexThreePos, color, depth);
+				indices[numIndices++] = inner;
+				indices[numIndices++] = outerIn;
+				indices[numIndices++] = outerOut;
+			}
+		}
 
-			makeTriangle = false;
-			i--;
+		if (i > 0) {
+			indices[numIndices++] = prevLeft;
+			indices[numIndices++] = prevRight;
+			indices[numIndices++] = inRight;
+			indices[numIndices++] = prevLeft;
+			indices[numIndices++] = inRight;
+			indices[numIndices++] = inLeft;
 		}
+
+		prevLeft = outLeft;
+		prevRight = outRight;
 	}
+
+	trimLastShape(numVertices, numIndices);
 }
 
-void Evolve::ShapeRenderer::end(const ShapeSortType& sortType /*= ShapeSortType::BY_DEPTH_INCREMENTAL*/) {
-	if (!inited_) {
-		EVOLVE_REPORT_ERROR("Texture renderer not initialized.", begin);
+void Evolve::ShapeRenderer::drawPolyline(const std::vector<Position2D>& points, float thickness,
+	const ColorRgba& color, int depth /*= 0*/) {
+	drawPolyline(points.data(), points.size(), thickness, color, depth);
+}
+
+void Evolve::ShapeRenderer::drawConvexPolygon(const Position2D* points, size_t numPoints, 
+	const ColorRgba& color, int depth /*= 0*/) {
+	
+	if (numPoints < 3) {
 		return;
 	}
 
-	if (!shapes_.empty()) {
-		shapePointers_.resize(shapes_.size());
+	GLuint* indices = nullptr;
+	Vertex2D* vertices = reserveShape(depth, (unsigned int) numPoints, ((unsigned int) numPoints - 2) * 3, indices);
 
-		for (size_t i = 0; i < shapePointers_.size(); i++) {
-			shapePointers_[i] = &shapes_[i];
-		}
+	for (size_t i = 0; i < numPoints; i++) {
+		vertices[i].setPosition(points[i]);
+		vertices[i].setColor(color);
+	}
+
+	// a fan around the first point
+	for (unsigned int i = 1; i + 1 < numPoints; i++) {
+		*indices++ = 0;
+		*indices++ = i;
+		*indices++ = i + 1;
+	}
+}
 
-		switch (sortType) {
+void Evolve::ShapeRenderer::drawConvexPolygon(const std::vector<Position2D>& points, 
+	const ColorRgba& color, int depth /*= 0*/) {
+	drawConvexPolygon(points.data(), points.size(), color, depth);
+}
 
-		case ShapeSortType::BY_DEPTH_INCREMENTAL:
-			std::stable_sort(shapePointers_.begin(), shapePointers_.end(), compareByDepthIncremental);
-			break;
+void Evolve::ShapeRenderer::drawPolygon(const Position2D* points, size_t numPoints, 
+	const ColorRgba& color, int depth /*= 0*/) {
+	
+	if (numPoints < 3) {
+		return;
+	}
+
+	GLuint* indices = nullptr;
+	Vertex2D* vertices = reserveShape(depth, (unsigned int) numPoints, ((unsigned int) numPoints - 2) * 3, indices);
+
+	for (size_t i = 0; i < numPoints; i++) {
+		vertices[i].setPosition(points[i]);
+		vertices[i].setColor(color);
+	}
+
+	// twice the signed area, positive for counter clockwise polygons
+	long long doubleArea = 0;
+	for (size_t i = 0, j = numPoints - 1; i < numPoints; j = i++) {
+		doubleArea += (long long) points[j].X * points[i].Y - (long long) points[i].X * points[j].Y;
+	}
+	const long long winding = doubleArea >= 0 ? 1 : -1;
+
+	polygonScratch_.resize(numPoints);
+	for (size_t i = 0; i < numPoints; i++) {
+		polygonScratch_[i] = (GLuint) i;
+	}
+
+	size_t current = 0;
+	size_t attempts = 0;
+
+	while (polygonScratch_.size() > 3) {
+		size_t remaining = polygonScratch_.size();
+		
+		GLuint prev = polygonScratch_[(current + remaining - 1) % remaining];
+		GLuint ear = polygonScratch_[current];
+		GLuint next = polygonScratch_[(current + 1) % remaining];
 
-		case ShapeSortType::BY_DEPTH_DECREMENTAL:
-			std::stable_sort(shapePointers_.begin(), shapePointers_.end(), compareByDepthDecremental);
+		// an ear is a convex corner with no other remaining vertex inside its triangle
+		bool isEar = crossProduct(points[prev], points[ear], points[next]) * winding > 0;
+
+		for (size_t i = 0; isEar && i < remaining; i++) {
+			GLuint other = polygonScratch_[i];
+			
+			if (other == prev || other == ear || other == next) {
+				continue;
+			}
+
+			if (crossProduct(points[prev], points[ear], points[other]) * winding >= 0 &&
+				crossProduct(points[ear], points[next], points[other]) * winding >= 0 &&
+				crossProduct(points[next], points[prev], points[other]) * winding >= 0) {
+				isEar = false;
+			}
+		}
+
+		if (isEar) {
+			*indices++ = prev;
+			*indices++ = ear;
+			*indices++ = next;
+
+			polygonScratch_.erase(polygonScratch_.begin() + current);
+			current %= polygonScratch_.size();
+			attempts = 0;
+		}
+		else if (++attempts > remaining) {
+			// no ear left means the polygon isn't simple, fill the rest as a fan rather than loop forever
 			break;
 		}
+		else {
+			current = (current + 1) % remaining;
+		}
+	}
+
+	for (size_t i = 1; i + 1 < polygonScratch_.size(); i++) {
+		*indices++ = polygonScratch_[0];
+		*indices++ = polygonScratch_[i];
+		*indices++ = polygonScratch_[i + 1];
+	}
+}
+
+void Evolve::ShapeRenderer::drawPolygon(const std::vector<Position2D>& points, 
+	const ColorRgba& color, int depth /*= 0*/) {
+	drawPolygon(points.data(), points.size(), color, depth);
+}
+
+void Evolve::ShapeRenderer::setTessellationTolerance(float maxErrorPixels, float pixelsPerUnit /*= 1.0f*/) {
+	if (maxErrorPixels <= 0.0f || pixelsPerUnit <= 0.0f) {
+		EVOLVE_REPORT_ERROR("Tessellation tolerance and pixels per unit must be positive.", setTessellationTolerance);
+		return;
+	}
+
+	tessellationTolerance_ = maxErrorPixels;
+	pixelsPerUnit_ = pixelsPerUnit;
+}
+
+void Evolve::ShapeRenderer::drawSmoothCircle(const Position2D& centerPos, float radius, 
+	const ColorRgba& color, int depth /*= 0*/) {
+	addSdfQuad(depth, (float) centerPos.X, (float) centerPos.Y, 1.0f, 0.0f, 
+		radius, radius, radius, 0.0f, color);
+}
+
+void Evolve::ShapeRenderer::drawRing(const Position2D& centerPos, float radius, float thickness,
+	const ColorRgba& color, int depth /*= 0*/) {
+	addSdfQuad(depth, (float) centerPos.X, (float) centerPos.Y, 1.0f, 0.0f,
+		radius, radius, radius, std::min(thickness, radius), color);
+}
+
+void Evolve::ShapeRenderer::drawRoundedRectangle(const RectDimension& destRect, float cornerRadius,
+	const ColorRgba& color, int depth /*= 0*/) {
+	float halfWidth = destRect.getWidth() / 2.0f;
+	float halfHeight = destRect.getHeight() / 2.0f;
+
+	cornerRadius = std::max(0.0f, std::min(cornerRadius, std::min(halfWidth, halfHeight)));
+
+	addSdfQuad(depth, destRect.getLeft() + halfWidth, destRect.getBottom() + halfHeight, 1.0f, 0.0f,
+		halfWidth, halfHeight, cornerRadius, 0.0f, color);
+}
+
+void Evolve::ShapeRenderer::drawLine(const Position2D& startPos, const Position2D& endPos, float thickness,
+	const ColorRgba& color, int depth /*= 0*/, bool roundCaps /*= false*/) {
+	
+	float dirX = (float) (endPos.X - startPos.X);
+	float dirY = (float) (endPos.Y - startPos.Y);
+	float length = std::sqrt(dirX * dirX + dirY * dirY);
+
+	// a zero length line has no direction, draw it along the x axis
+	if (length > 0.0f) {
+		dirX /= length;
+		dirY /= length;
+	}
+	else {
+		dirX = 1.0f;
+		dirY = 0.0f;
+	}
+
+	float halfThickness = thickness / 2.0f;
+
+	// a round capped line is a box rounded by half its thickness, extended by the caps
+	float halfLength = length / 2.0f + (roundCaps ? halfThickness : 0.0f);
+
+	addSdfQuad(depth, (startPos.X + endPos.X) / 2.0f, (startPos.Y + endPos.Y) / 2.0f, dirX, dirY,
+		halfLength, halfThickness, roundCaps ? halfThickness : 0.0f, 0.0f, color);
+}
+
+void Evolve::ShapeRenderer::end(const ShapeSortType& sortType /*= ShapeSortType::BY_DEPTH_INCREMENTAL*/) {
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Texture renderer not initialized.", begin);
+		return;
+	}
+
+	if (!shapes_.empty()) {
+		sortShapes(sortType);
 
 		setupShapeBatches();
 	}
@@ -255,47 +529,74 @@ void Evolve::ShapeRenderer::renderShapes(Camera& camera, GlslProgram* shader /*=
 		currentShader_ = &defaultShader_;
 	}
 
-	currentShader_->useProgram();
+	// uniforms stay with their program, so both get the camera matrix once
+	sdfShader_.useProgram();
+	camera.sendMatrixDataToShader(sdfShader_);
 
+	currentShader_->useProgram();
 	camera.sendMatrixDataToShader(*currentShader_);
 
-	if (!shapeBatches_.empty()) {
-		glBindVertexArray(vaoID_);
-
-		for (auto& batch : shapeBatches_) {
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.iboID_);
-			glDrawElements(GL_TRIANGLES, batch.numIndices_, GL_UNSIGNED_INT, nullptr);
-		}
+	bool sdfBound = false;
 
-		glBindVertexArray(0);
+	for (size_t i = 0; i < shapeBatches_.size(); i++) {
+		auto& batch = shapeBatches_[i];
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		// consecutive batches always differ in their kind, except the first one
+		if (i == 0 || batch.isSdf_ != sdfBound) {
+			if (batch.isSdf_) {
+				sdfShader_.useProgram();
+				glBindVertexArray(sdfVaoID_);
+			}
+			else {
+				currentShader_->useProgram();
+				glBindVertexArray(vaoID_);
+			}
+			sdfBound = batch.isSdf_;
+		}
 
-		glDisableVertexAttribArray(0);
-		glDisableVertexAttribArray(1);
+		glDrawElements(GL_TRIANGLES, batch.numIndices_, GL_UNSIGNED_INT,
+			(void*) (batch.offset_ * sizeof(GLuint)));
 	}
 
+	glBindVertexArray(0);
+
 	currentShader_->unuseProgram();
 }
 
 void Evolve::ShapeRenderer::freeShapeRenderer() {
 	if (inited_) {
 		defaultShader_.freeProgram();
+		sdfShader_.freeProgram();
+		inited_ = false;
 	}
 
-	if (!iboIDs_.empty()) {
-		glDeleteBuffers((GLsizei)iboIDs_.size(), iboIDs_.data());
+	if (iboID_ != 0) {
+		glDeleteBuffers(1, &iboID_);
+		iboID_ = 0;
+		iboCapacity_ = 0;
 	}
 
 	if (vboID_ != 0) {
 		glDeleteBuffers(1, &vboID_);
 		vboID_ = 0;
+		vboCapacity_ = 0;
 	}
 
 	if (vaoID_ != 0) {
 		glDeleteVertexArrays(1, &vaoID_);
 		vaoID_ = 0;
 	}
+
+	if (sdfVboID_ != 0) {
+		glDeleteBuffers(1, &sdfVboID_);
+		sdfVboID_ = 0;
+		sdfVboCapacity_ = 0;
+	}
+
+	if (sdfVaoID_ != 0) {
+		glDeleteVertexArrays(1, &sdfVaoID_);
+		sdfVaoID_ = 0;
+	}
 }
 
 void Evolve::ShapeRenderer::createVao() {
@@ -307,135 +608,279 @@ void Evolve::ShapeRenderer::createVao() {
 		glGenBuffers(1, &vboID_);
 	}
 
+	if (iboID_ == 0) {
+		glGenBuffers(1, &iboID_);
+	}
+
 	glBindVertexArray(vaoID_);
 
 	glBindBuffer(GL_ARRAY_BUFFER, vboID_);
 
+	// the element buffer binding is part of the vao state
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboID_);
+
 	glEnableVertexAttribArray(0);
 	glEnableVertexAttribArray(1);
 
 	glVertexAttribPointer(0, 2, GL_INT, GL_FALSE, sizeof(Vertex2D), (void*) offsetof(Vertex2D, Position));
 	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex2D), (void*) offsetof(Vertex2D, Color));
 
+	if (sdfVaoID_ == 0) {
+		glGenVertexArrays(1, &sdfVaoID_);
+	}
+
+	if (sdfVboID_ == 0) {
+		glGenBuffers(1, &sdfVboID_);
+	}
+
+	glBindVertexArray(sdfVaoID_);
+
+	glBindBuffer(GL_ARRAY_BUFFER, sdfVboID_);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboID_);
+
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glEnableVertexAttribArray(3);
+
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex2D), (void*) offsetof(SdfVertex2D, X));
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SdfVertex2D), (void*) offsetof(SdfVertex2D, Color));
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex2D), (void*) offsetof(SdfVertex2D, LocalX));
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SdfVertex2D), (void*) offsetof(SdfVertex2D, HalfWidth));
+
 	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void Evolve::ShapeRenderer::setupShapeBatches() {
-	if (!shapePointers_.empty()) {
-		{
-			// setup the vbo and buffer vertex data
-			std::vector<Vertex2D> vertices;
-			vertices.resize(totalVertices_);
+	if (!sortEntries_.empty()) {
+		// gather the vertices and rebased indices of the shapes in sorted order, 
+		// then upload them to the persistent vbos and ibo
+		vertices_.resize(vertexArena_.size());
+		sdfVertices_.resize(sdfVertexArena_.size());
+		vertexIndices_.resize(indexArena_.size());
+
+		unsigned int currentVertex = 0;
+		unsigned int currentSdfVertex = 0;
+		unsigned int currentIndex = 0;
+
+		for (auto& entry : sortEntries_) {
+			const Shape& shape = shapes_[entry.Index];
+
+			// the shape shaders have no per batch state, so a batch is a run of shapes of the same kind
+			if (shapeBatches_.empty() || shapeBatches_.back().isSdf_ != shape.IsSdf) {
+				shapeBatches_.emplace_back(currentIndex, 0, shape.IsSdf);
+			}
 
-			unsigned int currentVertex = 0;
+			unsigned int baseVertex;
 
-			for (auto& shape : shapePointers_) {
-				for (size_t vertex = 0; vertex < shape->vertices_.size(); vertex++) {
-					vertices[currentVertex++] = shape->vertices_[vertex];
-				}
+			if (shape.IsSdf) {
+				memcpy(&sdfVertices_[currentSdfVertex], &sdfVertexArena_[shape.VertexOffset],
+					shape.NumVertices * sizeof(SdfVertex2D));
+				baseVertex = currentSdfVertex;
+				currentSdfVertex += shape.NumVertices;
+			}
+			else {
+				memcpy(&vertices_[currentVertex], &vertexArena_[shape.VertexOffset], 
+					shape.NumVertices * sizeof(Vertex2D));
+				baseVertex = currentVertex;
+				currentVertex += shape.NumVertices;
 			}
 
-			glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+			for (unsigned int i = 0; i < shape.NumIndices; i++) {
+				vertexIndices_[currentIndex++] = baseVertex + indexArena_[shape.IndexOffset + i];
+			}
 
-			glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex2D), nullptr, GL_DYNAMIC_DRAW);
+			shapeBatches_.back().numIndices_ += shape.NumIndices;
+		}
 
-			glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex2D), vertices.data());
+		if (!vertices_.empty()) {
+			uploadBufferData(GL_ARRAY_BUFFER, vboID_, vboCapacity_,
+				vertices_.size() * sizeof(Vertex2D), vertices_.data());
+		}
 
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		if (!sdfVertices_.empty()) {
+			uploadBufferData(GL_ARRAY_BUFFER, sdfVboID_, sdfVboCapacity_,
+				sdfVertices_.size() * sizeof(SdfVertex2D), sdfVertices_.data());
 		}
 
+		uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, iboID_, iboCapacity_,
+			vertexIndices_.size() * sizeof(GLuint), vertexIndices_.data());
 
-		{
-			// Setup render batches and the ibo
-			std::vector<GLuint> vertexIndices;
-			vertexIndices.resize(totalIndices_);
+		stats_.NumVertices = vertices_.size() + sdfVertices_.size();
+		stats_.NumDrawCalls = (unsigned int) shapeBatches_.size();
+	}
+}
 
-			unsigned int curentIndex = 0;
-			unsigned int currentVertex = 0;
+void Evolve::ShapeRenderer::uploadBufferData(GLenum target, GLuint bufferID, GLsizeiptr& capacity,
+	GLsizeiptr size, const void* data) {
 
-			shapeBatches_.emplace_back(curentIndex, shapePointers_[0]->numIndices_);
-			addIndicesToBuffer(vertexIndices, shapePointers_[0]->numIndices_, curentIndex, currentVertex);
+	// the ibo is bound through the vao, so bind the vao to not disturb any other vao's state
+	glBindVertexArray(vaoID_);
+	glBindBuffer(target, bufferID);
 
-			for (size_t i = 1; i < shapePointers_.size(); i++) {
+	if (size > capacity) {
+		// grow geometrically so the storage is reallocated only a few times
+		capacity = std::max(size, capacity * 2);
+	}
 
-				auto numIndices = shapePointers_[i]->numIndices_;
+	// respecifying the whole storage with no data orphans the old one, 
+	// so the driver doesn't have to wait for the previous frame's draw calls to finish
+	glBufferData(target, capacity, nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(target, 0, size, data);
 
-				if (shapePointers_[i]->depth_ == shapePointers_[i - 1]->depth_) {
-					shapeBatches_.back().numIndices_ += numIndices;
-				}
-				else {
-					shapeBatches_.emplace_back(curentIndex, numIndices);
-				}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-				addIndicesToBuffer(vertexIndices, numIndices, curentIndex, currentVertex);
-			}
+Evolve::Vertex2D* Evolve::ShapeRenderer::addShape(int depth, unsigned int numVertices,
+	const GLuint* indices, unsigned int numIndices) {
 
-			iboIDs_.resize(shapeBatches_.size());
+	GLuint* shapeIndices = nullptr;
+	Vertex2D* vertices = reserveShape(depth, numVertices, numIndices, shapeIndices);
 
-			glGenBuffers((GLsizei)iboIDs_.size(), iboIDs_.data());
+	std::copy(indices, indices + numIndices, shapeIndices);
 
-			for (size_t i = 0; i < iboIDs_.size(); i++) {
+	return vertices;
+}
 
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboIDs_[i]);
+Evolve::Vertex2D* Evolve::ShapeRenderer::reserveShape(int depth, unsigned int numVertices,
+	unsigned int numIndices, GLuint*& indices) {
 
-				glBufferData(GL_ELEMENT_ARRAY_BUFFER, shapeBatches_[i].numIndices_ * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+	Shape shape;
+	shape.Depth = depth;
+	shape.IsSdf = false;
+	shape.VertexOffset = (unsigned int) vertexArena_.size();
+	shape.NumVertices = numVertices;
+	shape.IndexOffset = (unsigned int) indexArena_.size();
+	shape.NumIndices = numIndices;
 
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, shapeBatches_[i].numIndices_ * sizeof(GLuint), &vertexIndices[shapeBatches_[i].offset_]);
+	shapes_.push_back(shape);
 
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	indexArena_.resize(indexArena_.size() + numIndices);
+	vertexArena_.resize(vertexArena_.size() + numVertices);
 
-				shapeBatches_[i].iboID_ = iboIDs_[i];
-			}
-		}
-	}
+	indices = indexArena_.data() + shape.IndexOffset;
+	return &vertexArena_[shape.VertexOffset];
 }
 
-void Evolve::ShapeRenderer::addIndicesToBuffer(std::vector<GLuint>& indices, const int numIndices, 
-	unsigned int& currentIndex, unsigned int& currentVertex) {
+void Evolve::ShapeRenderer::trimLastShape(unsigned int numVertices, unsigned int numIndices) {
+	Shape& shape = shapes_.back();
+
+	shape.NumVertices = numVertices;
+	shape.NumIndices = numIndices;
 
-	// triangle
-	if (numIndices == 3) {
-		indices[currentIndex++] = currentVertex;
-		indices[currentIndex++] = currentVertex + 1; 
-		indices[currentIndex++] = currentVertex + 2;
+	vertexArena_.resize(shape.VertexOffset + numVertices);
+	indexArena_.resize(shape.IndexOffset + numIndices);
+}
 
-		currentVertex += 3;
+void Evolve::ShapeRenderer::addSdfQuad(int depth, float centerX, float centerY, float axisX, float axisY,
+	float halfWidth, float halfHeight, float cornerRadius, float outlineThickness, const ColorRgba& color) {
+	Shape shape;
+	shape.Depth = depth;
+	shape.IsSdf = true;
+	shape.VertexOffset = (unsigned int) sdfVertexArena_.size();
+	shape.NumVertices = 4;
+	shape.IndexOffset = (unsigned int) indexArena_.size();
+	shape.NumIndices = 6;
+	shapes_.push_back(shape);
+
+	indexArena_.insert(indexArena_.end(), QUAD_INDICES, QUAD_INDICES + 6);
+
+	float extentX = halfWidth + SDF_QUAD_PADDING;
+	float extentY = halfHeight + SDF_QUAD_PADDING;
+
+	// bottom left, bottom right, top right, top left in the shape's own axes
+	const float localCorners[4][2] = {
+		{ -extentX, -extentY }, { extentX, -extentY }, { extentX, extentY }, { -extentX, extentY }
+	};
+
+	for (int i = 0; i < 4; i++) {
+		float localX = localCorners[i][0];
+		float localY = localCorners[i][1];
+
+		SdfVertex2D vertex;
+		// the local y axis is the x axis rotated by 90 degrees
+		vertex.X = centerX + localX * axisX - localY * axisY;
+		vertex.Y = centerY + localX * axisY + localY * axisX;
+		vertex.Color = color;
+		vertex.LocalX = localX;
+		vertex.LocalY = localY;
+		vertex.HalfWidth = halfWidth;
+		vertex.HalfHeight = halfHeight;
+		vertex.CornerRadius = cornerRadius;
+		vertex.OutlineThickness = outlineThickness;
+
+		sdfVertexArena_.push_back(vertex);
 	}
-	
-	// quad
-	else if (numIndices == 6) {
-	
-		// first triangle
-		indices[currentIndex++] = currentVertex; // botom left
-		indices[currentIndex++] = currentVertex + 1; // bottom right
-		indices[currentIndex++] = currentVertex + 2; // top right
+}
 
-		// second triangle
-		indices[currentIndex++] = currentVertex; // bottom left
-		indices[currentIndex++] = currentVertex + 3; // top left
-		indices[currentIndex++] = currentVertex + 2; // top right
+unsigned int Evolve::ShapeRenderer::getCircleSegments(float radius) const {
+	float screenRadius = radius * pixelsPerUnit_;
 
-		currentVertex += 4;
+	if (screenRadius <= tessellationTolerance_) {
+		return MIN_CIRCLE_SEGMENTS;
 	}
 
-	// circle
-	else {
-		for (int i = 0; i < numIndices; i++) {
-			indices[currentIndex++] = currentVertex + i;
-		}
+	// a chord spanning the angle a deviates from the arc by r * (1 - cos(a / 2)),
+	// so the largest angle within the tolerance is 2 * acos(1 - tolerance / r)
+	double maxAngle = 2.0 * std::acos(1.0 - tessellationTolerance_ / screenRadius);
+	unsigned int numSegments = (unsigned int) std::ceil((M_PI * 2.0) / maxAngle);
 
-		currentVertex += numIndices;
-	}
+	numSegments = (numSegments + CIRCLE_SEGMENTS_STEP - 1) / CIRCLE_SEGMENTS_STEP * CIRCLE_SEGMENTS_STEP;
+
+	return std::max(MIN_CIRCLE_SEGMENTS, std::min(numSegments, MAX_CIRCLE_SEGMENTS));
 }
 
-bool Evolve::ShapeRenderer::compareByDepthIncremental(Shape* a, Shape* b) {
-	return (a->depth_ < b->depth_);
+const Evolve::ShapeRenderer::CircleTable& Evolve::ShapeRenderer::getCircleTable(unsigned int numSegments) {
+	auto it = circleTables_.find(numSegments);
+
+	if (it != circleTables_.end()) {
+		return it->second;
+	}
+
+	CircleTable& table = circleTables_[numSegments];
+
+	table.Points.resize(numSegments * 2);
+	table.FanIndices.resize(numSegments * 3);
+
+	for (unsigned int i = 0; i < numSegments; i++) {
+		double angle = (M_PI * 2.0) * ((double) i / (double) numSegments);
+		table.Points[i * 2] = (GLfloat) std::cos(angle);
+		table.Points[i * 2 + 1] = (GLfloat) std::sin(angle);
+
+		// the center, this rim vertex and the next, wrapping around to the first
+		table.FanIndices[i * 3] = 0;
+		table.FanIndices[i * 3 + 1] = i + 1;
+		table.FanIndices[i * 3 + 2] = (i + 1) % numSegments + 1;
+	}
+
+	return table;
 }
 
-bool Evolve::ShapeRenderer::compareByDepthDecremental(Shape* a, Shape* b) {
-	return (a->depth_ > b->depth_);
+void Evolve::ShapeRenderer::sortShapes(const ShapeSortType& sortType) {
+
+	// the depth with its sign bit flipped orders negative depths before positive ones,
+	// inverting the key sorts decrementally while keeping the sort stable
+	const bool decremental = sortType == ShapeSortType::BY_DEPTH_DECREMENTAL;
+
+	sortEntries_.resize(shapes_.size());
+
+	for (size_t i = 0; i < shapes_.size(); i++) {
+		uint32_t depthKey = (uint32_t) shapes_[i].Depth ^ 0x80000000u;
+
+		if (decremental) {
+			depthKey = ~depthKey;
+		}
+
+		// within a depth the tessellated shapes go before the smooth ones, so each kind forms one batch
+		sortEntries_[i].Key = ((uint64_t) depthKey << 1) | (shapes_[i].IsSdf ? 1u : 0u);
+		sortEntries_[i].Index = (uint32_t) i;
+	}
+
+	radixSortEntries(sortEntries_, sortScratch_);
 }
 
-Evolve::ShapeRenderer::ShapeBatch::ShapeBatch(unsigned int offset, unsigned int numIndices) :
-	offset_(offset), numIndices_(numIndices)
+Evolve::ShapeRenderer::ShapeBatch::ShapeBatch(unsigned int offset, unsigned int numIndices, bool isSdf) :
+	offset_(offset), numIndices_(numIndices), isSdf_(isSdf)
 {}
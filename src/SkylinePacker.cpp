@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/SkylinePacker.h"
+
+void Evolve::SkylinePacker::init(const int width, const int height) {
+	width_ = width;
+	height_ = height;
+
+	nodes_.clear();
+	nodes_.push_back({ 0, 0, width });
+}
+
+bool Evolve::SkylinePacker::insert(const int width, const int height, int& x, int& y) {
+	if (!findPosition(width, height, x, y)) {
+		return false;
+	}
+
+	addNode(x, y, width, height);
+	return true;
+}
+
+bool Evolve::SkylinePacker::findPosition(const int width, const int height, int& x, int& y) const {
+	int bestY = INT_MAX, bestWidth = INT_MAX;
+	bool found = false;
+
+	for (size_t i = 0; i < nodes_.size(); i++) {
+		int nodeX = nodes_[i].X;
+
+		if (nodeX + width > width_) {
+			break;
+		}
+
+		// the rect rests on the highest node it spans
+		int nodeY = 0;
+		int widthLeft = width;
+
+		for (size_t j = i; widthLeft > 0; j++) {
+			nodeY = std::max(nodeY, nodes_[j].Y);
+			widthLeft -= nodes_[j].Width;
+		}
+
+		if (nodeY + height > height_) {
+			continue;
+		}
+
+		// the lowest position wins, the narrowest node breaks ties to leave wider gaps open
+		if (nodeY < bestY || (nodeY == bestY && nodes_[i].Width < bestWidth)) {
+			bestY = nodeY;
+			bestWidth = nodes_[i].Width;
+			x = nodeX;
+			y = nodeY;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+void Evolve::SkylinePacker::addNode(const int x, const int y, const int width, const int height) {
+	auto& skyline = nodes_;
+
+	size_t index = 0;
+	while (skyline[index].X != x) {
+		index++;
+	}
+
+	skyline.insert(skyline.begin() + index, { x, y + height, width });
+
+	// shrink or remove the nodes the new one covers
+	size_t next = index + 1;
+	while (next < skyline.size()) {
+		int overlap = x + width - skyline[next].X;
+
+		if (overlap <= 0) {
+			break;
+		}
+
+		if (overlap < skyline[next].Width) {
+			skyline[next].X += overlap;
+			skyline[next].Width -= overlap;
+			break;
+		}
+
+		skyline.erase(skyline.begin() + next);
+	}
+
+	// merge neighbours at the same height
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].Y == skyline[i + 1].Y) {
+			skyline[i].Width += skyline[i + 1].Width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else {
+			i++;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/StaticSpriteLayer.h"
+
+Evolve::StaticSpriteLayer::StaticSpriteLayer() {}
+
+Evolve::StaticSpriteLayer::~StaticSpriteLayer() {
+	freeStaticSpriteLayer();
+}
+
+bool Evolve::StaticSpriteLayer::init(const std::string& pathToAssets,
+	const TextureBatchingMode batchingMode /*= TextureBatchingMode::MULTI_TEXTURE*/,
+	const GlyphSortType& sortType /*= GlyphSortType::BY_DEPTH_AND_TEXTURE_ID_INCREMENTAL*/) {
+
+	if (!textureRenderer_.init(pathToAssets, batchingMode, BufferUploadMode::STATIC)) {
+		EVOLVE_REPORT_ERROR("Failed to initialize the texture renderer of the layer.", init);
+		return false;
+	}
+
+	sortType_ = sortType;
+	changed_ = true;
+
+	inited_ = true;
+	return true;
+}
+
+size_t Evolve::StaticSpriteLayer::addSprite(const RectDimension& destRect, const UvDimension& uvRect,
+	GLuint textureID, const ColorRgba& color, int depth /*= 0*/) {
+
+	sprites_.push_back({ destRect, uvRect, textureID, color, depth, true });
+	changed_ = true;
+
+	return sprites_.size() - 1;
+}
+
+void Evolve::StaticSpriteLayer::setSprite(const size_t id, const RectDimension& destRect, 
+	const UvDimension& uvRect, GLuint textureID, const ColorRgba& color, int depth /*= 0*/) {
+
+	if (id >= sprites_.size()) {
+		EVOLVE_REPORT_ERROR("Invalid sprite ID used.", setSprite);
+		return;
+	}
+
+	sprites_[id] = { destRect, uvRect, textureID, color, depth, sprites_[id].IsVisible };
+	changed_ = true;
+}
+
+void Evolve::StaticSpriteLayer::showSprite(const size_t id) {
+
+	if (id >= sprites_.size()) {
+		EVOLVE_REPORT_ERROR("Invalid sprite ID used.", showSprite);
+		return;
+	}
+
+	if (!sprites_[id].IsVisible) {
+		sprites_[id].IsVisible = true;
+		changed_ = true;
+	}
+}
+
+void Evolve::StaticSpriteLayer::hideSprite(const size_t id) {
+
+	if (id >= sprites_.size()) {
+		EVOLVE_REPORT_ERROR("Invalid sprite ID used.", hideSprite);
+		return;
+	}
+
+	if (sprites_[id].IsVisible) {
+		sprites_[id].IsVisible = false;
+		changed_ = true;
+	}
+}
+
+void Evolve::StaticSpriteLayer::clear() {
+	sprites_.clear();
+	changed_ = true;
+}
+
+void Evolve::StaticSpriteLayer::renderLayer(Camera& camera, GlslProgram* shader /*= nullptr*/) {
+
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Static sprite layer not initialized.", renderLayer);
+		return;
+	}
+
+	if (changed_) {
+		rebuild();
+	}
+
+	textureRenderer_.renderTextures(camera, shader);
+}
+
+void Evolve::StaticSpriteLayer::freeStaticSpriteLayer() {
+	textureRenderer_.freeTextureRenderer();
+
+	sprites_.clear();
+	inited_ = false;
+}
+
+void Evolve::StaticSpriteLayer::rebuild() {
+
+	textureRenderer_.begin();
+
+	for (auto& sprite : sprites_) {
+		if (sprite.IsVisible) {
+			textureRenderer_.draw(sprite.DestRect, sprite.UvRect, sprite.TextureID, sprite.Color, sprite.Depth);
+		}
+	}
+
+	textureRenderer_.end(sortType_);
+
+	changed_ = false;
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/StreamingTexture.h"
+
+Evolve::StreamingTexture::StreamingTexture() {}
+
+Evolve::StreamingTexture::~StreamingTexture() {
+	freeStreamingTexture();
+}
+
+bool Evolve::StreamingTexture::init(const std::string& bakedFilePath, const unsigned int tailSize /*= 256*/) {
+	freeStreamingTexture();
+
+	if (!file_.openFile(bakedFilePath, MappedFileAccess::RANDOM)) {
+		EVOLVE_REPORT_ERROR("Failed to map the baked texture file.", init);
+		return false;
+	}
+
+	if (!BakedAtlas::validateFile(file_, bakedFilePath)) {
+		file_.closeFile();
+		return false;
+	}
+
+	BakedAtlasHeader header;
+	memcpy(&header, file_.getData(), sizeof(header));
+
+	if (header.NumPages != 1) {
+		std::string errStr = bakedFilePath + " is not a baked texture, it has " + 
+			std::to_string(header.NumPages) + " pages.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), init);
+		file_.closeFile();
+		return false;
+	}
+
+	width_ = (int) header.PageWidth;
+	height_ = (int) header.PageHeight;
+	colorChannels_ = header.ColorChannels;
+
+	levels_ = (const BakedAtlasLevel*) (file_.getData() + header.LevelTableOffset);
+	numLevels_ = header.NumMipLevels;
+
+	// the tail starts at the finest level within the tail size, or the coarsest level
+	tailLevel_ = numLevels_ - 1;
+	while (tailLevel_ > 0 && levels_[tailLevel_ - 1].Width <= tailSize && levels_[tailLevel_ - 1].Height <= tailSize) {
+		tailLevel_--;
+	}
+
+	glGenTextures(1, &textureID_);
+	glBindTexture(GL_TEXTURE_2D, textureID_);
+
+	if (colorChannels_ == 1) {
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, numLevels_ - 1);
+
+	for (unsigned int level = numLevels_; level-- > tailLevel_;) {
+		uploadLevel(level);
+	}
+
+	setBaseLevel(tailLevel_);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	residentLevel_ = tailLevel_;
+	targetLevel_ = tailLevel_;
+
+	inited_ = true;
+	return true;
+}
+
+void Evolve::StreamingTexture::setScreenSize(const float width, const float height) {
+	if (!inited_) {
+		return;
+	}
+
+	// the coarsest level that still has at least a texel per screen pixel on both sides
+	unsigned int level = 0;
+	while (level < tailLevel_ && 
+		levels_[level + 1].Width >= width && levels_[level + 1].Height >= height) {
+		level++;
+	}
+
+	targetLevel_ = level;
+}
+
+void Evolve::StreamingTexture::update(const size_t budgetBytes /*= 4 * 1024 * 1024*/) {
+	if (!inited_) {
+		return;
+	}
+
+	// release the levels that got too fine, keeping one extra level so small changes don't thrash
+	if (targetLevel_ > residentLevel_ + 1 || (uploading_ && targetLevel_ >= residentLevel_)) {
+		glBindTexture(GL_TEXTURE_2D, textureID_);
+
+		if (uploading_) {
+			releaseLevel(residentLevel_ - 1);
+			uploading_ = false;
+		}
+
+		while (residentLevel_ < targetLevel_ && residentLevel_ < tailLevel_) {
+			// the base level moves first so the texture stays complete
+			setBaseLevel(residentLevel_ + 1);
+			releaseLevel(residentLevel_);
+			residentLevel_++;
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return;
+	}
+
+	if (targetLevel_ >= residentLevel_) {
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, textureID_);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	unsigned int level = residentLevel_ - 1;
+	const BakedAtlasLevel& bakedLevel = levels_[level];
+
+	if (!uploading_) {
+		// allocate the level without pixels, its rows are filled over the next frames
+		glTexImage2D(GL_TEXTURE_2D, level, getInternalFormat(), bakedLevel.Width, bakedLevel.Height,
+			0, getPixelFormat(), GL_UNSIGNED_BYTE, nullptr);
+
+		residentBytes_ += bakedLevel.Size;
+		uploading_ = true;
+		uploadedRows_ = 0;
+	}
+
+	size_t rowBytes = (size_t) bakedLevel.Width * colorChannels_;
+	unsigned int numRows = (unsigned int) std::max<size_t>(1, budgetBytes / rowBytes);
+	numRows = std::min(numRows, bakedLevel.Height - uploadedRows_);
+
+	glTexSubImage2D(GL_TEXTURE_2D, level, 0, uploadedRows_, bakedLevel.Width, numRows,
+		getPixelFormat(), GL_UNSIGNED_BYTE, file_.getData() + bakedLevel.Offset + uploadedRows_ * rowBytes);
+
+	uploadedRows_ += numRows;
+
+	if (uploadedRows_ == bakedLevel.Height) {
+		uploading_ = false;
+		residentLevel_ = level;
+		setBaseLevel(level);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Evolve::StreamingTexture::freeStreamingTexture() {
+	if (textureID_ != 0) {
+		glDeleteTextures(1, &textureID_);
+		textureID_ = 0;
+	}
+
+	file_.closeFile();
+
+	levels_ = nullptr;
+	numLevels_ = 0;
+	residentBytes_ = 0;
+	uploading_ = false;
+
+	inited_ = false;
+}
+
+void Evolve::StreamingTexture::uploadLevel(const unsigned int level) {
+	const BakedAtlasLevel& bakedLevel = levels_[level];
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	glTexImage2D(GL_TEXTURE_2D, level, getInternalFormat(), bakedLevel.Width, bakedLevel.Height,
+		0, getPixelFormat(), GL_UNSIGNED_BYTE, file_.getData() + bakedLevel.Offset);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	residentBytes_ += bakedLevel.Size;
+}
+
+void Evolve::StreamingTexture::releaseLevel(const unsigned int level) {
+	// respecifying a level as empty frees its storage
+	glTexImage2D(GL_TEXTURE_2D, level, getInternalFormat(), 0, 0, 0, getPixelFormat(), GL_UNSIGNED_BYTE, nullptr);
+
+	residentBytes_ -= levels_[level].Size;
+}
+
+void Evolve::StreamingTexture::setBaseLevel(const unsigned int level) {
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+}
\ No newline at end of file
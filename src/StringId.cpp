@@ -0,0 +1,49 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/StringId.h"
+
+namespace {
+	// interned strings are never freed, the deque keeps them in place as it grows
+	std::deque<std::string> internedStrings;
+	Evolve::FlatHashMap<uint64_t, const std::string*> internTable;
+	std::mutex internMutex;
+}
+
+Evolve::StringId Evolve::StringId::intern(const std::string& str) {
+	uint64_t hash = hashString(str.c_str());
+
+	std::lock_guard<std::mutex> lock(internMutex);
+
+	auto entry = internTable.tryEmplace(hash);
+
+	if (entry.second) {
+		internedStrings.push_back(str);
+		*entry.first = &internedStrings.back();
+	}
+	else if (**entry.first != str) {
+		std::string errStr = "Strings " + **entry.first + " and " + str + " have the same hash.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), intern);
+	}
+
+	return StringId((*entry.first)->c_str());
+}
\ No newline at end of file
@@ -0,0 +1,354 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/TextLayout.h"
+#include "../include/Evolve/Font.h"
+
+Evolve::TextLayout::TextLayout() {}
+
+Evolve::TextLayout::~TextLayout() {}
+
+bool Evolve::TextLayout::update(const Font& font, const char* text, 
+	const TextLayoutOptions& options /*= TextLayoutOptions()*/) {
+
+	bool sameOptions = options_.MaxWidth == options.MaxWidth && options_.Alignment == options.Alignment &&
+		options_.Kerning == options.Kerning;
+
+	if (font_ == &font && fontGeneration_ == font.getGeneration() && 
+		fontScale_ == font.getFontScale() && sameOptions && text_ == text) {
+		return false;
+	}
+
+	font_ = &font;
+	fontGeneration_ = font.getGeneration();
+	fontScale_ = font.getFontScale();
+	options_ = options;
+	text_ = text;
+
+	layoutText(font, text);
+	alignLines();
+	groupQuadsByTexture();
+
+	return true;
+}
+
+void Evolve::TextLayout::draw(TextureRenderer& textureRenderer, const int topLeftX, const int topLeftY,
+	const ColorRgba& color, const int depth /*= 0*/) {
+
+	// the color is kept in the quads, so it's only written again when it changes
+	if (color.Red != color_.Red || color.Green != color_.Green || 
+		color.Blue != color_.Blue || color.Alpha != color_.Alpha) {
+
+		for (auto& quad : quads_) {
+			quad.Color = color;
+		}
+
+		color_ = color;
+	}
+
+	for (auto& run : runs_) {
+		textureRenderer.draw(&quads_[run.First], run.Count, run.TextureID, topLeftX, topLeftY, depth);
+	}
+}
+
+void Evolve::TextLayout::clear() {
+	font_ = nullptr;
+	fontGeneration_ = 0;
+	fontScale_ = 0.0f;
+	text_.clear();
+
+	quads_.clear();
+	runs_.clear();
+	lines_.clear();
+
+	width_ = height_ = 0;
+}
+
+void Evolve::TextLayout::layoutText(const Font& font, const char* text) {
+
+	quads_.clear();
+	quadTextureIDs_.clear();
+	quadGaps_.clear();
+	lines_.clear();
+	lineQuads_.clear();
+
+	width_ = 0;
+	height_ = 0;
+
+	if (!font.initialized_) {
+		return;
+	}
+
+	const float scale = font.fontScale_;
+	const int maxWidth = options_.MaxWidth;
+
+	const int spaceAdvance = (int) ((font.spaceSize_ + font.addToSpaceLength_) * scale);
+	const int lineAdvance = (int) ((font.newLine_ + font.lineSpacing_) * scale);
+
+	// the line being laid out, its top goes down from the top of the text
+	int penX = 0;
+	int lineTop = 0;
+	size_t lineBegin = 0;
+	size_t lineFirstQuad = 0;
+	int lineGaps = 0;
+
+	// the glyph before the pen for kerning, 0 after a space or a line break
+	unsigned int previousGlyph = 0;
+	bool afterSpace = false;
+
+	// where the line can be wrapped, the last space between words, and the word after it
+	bool canWrap = false;
+	int wrapWidth = 0;
+	size_t wrapEnd = 0;
+	int wrapGaps = 0;
+
+	int wordX = 0;
+	size_t wordBegin = 0;
+	size_t wordFirstQuad = 0;
+
+	auto finishLine = [&](const int lineWidth, const size_t end, const size_t endQuad, 
+		const int gaps, const bool endsParagraph) {
+
+		TextLine line;
+		line.Begin = lineBegin;
+		line.End = end;
+		line.Top = lineTop;
+		line.Width = lineWidth;
+
+		lines_.push_back(line);
+
+		LineQuads quads;
+		quads.First = lineFirstQuad;
+		quads.Count = endQuad - lineFirstQuad;
+		quads.NumGaps = gaps;
+		quads.EndsParagraph = endsParagraph;
+
+		lineQuads_.push_back(quads);
+
+		width_ = std::max(width_, lineWidth);
+		lineTop += lineAdvance;
+	};
+
+	RectDimension currentDims;
+
+	size_t i = 0;
+
+	while (text[i] != '\0') {
+		size_t charBegin = i;
+		uint32_t codePoint = decodeUtf8(text, i);
+
+		if (codePoint == ' ') {
+			// a run of spaces after a word is one gap, the line can be wrapped at its start
+			if (!afterSpace && quads_.size() > lineFirstQuad) {
+				canWrap = true;
+				wrapWidth = penX;
+				wrapEnd = charBegin;
+				wrapGaps = lineGaps;
+
+				lineGaps++;
+			}
+
+			penX += spaceAdvance;
+
+			wordX = penX;
+			wordBegin = i;
+			wordFirstQuad = quads_.size();
+
+			previousGlyph = 0;
+			afterSpace = true;
+			continue;
+		}
+
+		if (codePoint == '\n') {
+			finishLine(penX, charBegin, quads_.size(), lineGaps, true);
+
+			penX = 0;
+			lineBegin = i;
+			lineFirstQuad = quads_.size();
+			lineGaps = 0;
+
+			canWrap = false;
+			previousGlyph = 0;
+			afterSpace = false;
+			continue;
+		}
+
+		const Font::Glyph* glyph = font.getGlyph(codePoint);
+
+		if (glyph == nullptr) {
+			continue;
+		}
+
+		int glyphX = penX;
+
+		if (options_.Kerning && previousGlyph != 0) {
+			glyphX += (int) (font.getKerning(previousGlyph, glyph->GlyphIndex) * scale);
+		}
+
+		if (maxWidth > 0 && glyphX + (int) (glyph->Advance * scale) > maxWidth) {
+
+			// the word moves down to a new line, only its quads are moved
+			if (canWrap) {
+				finishLine(wrapWidth, wrapEnd, wordFirstQuad, wrapGaps, false);
+
+				for (size_t quad = wordFirstQuad; quad < quads_.size(); quad++) {
+					quads_[quad].Left -= wordX;
+					quads_[quad].Right -= wordX;
+					quads_[quad].Top -= lineAdvance;
+					quads_[quad].Bottom -= lineAdvance;
+
+					quadGaps_[quad] = 0;
+				}
+
+				glyphX -= wordX;
+				penX -= wordX;
+
+				lineBegin = wordBegin;
+				lineFirstQuad = wordFirstQuad;
+				lineGaps = 0;
+
+				canWrap = false;
+			}
+
+			// a word longer than the line is broken before the glyph that doesn't fit
+			if (glyphX > 0 && glyphX + (int) (glyph->Advance * scale) > maxWidth) {
+				finishLine(penX, charBegin, quads_.size(), lineGaps, false);
+
+				penX = 0;
+				glyphX = 0;
+
+				lineBegin = charBegin;
+				lineFirstQuad = quads_.size();
+				lineGaps = 0;
+			}
+		}
+
+		if (glyph->TextureID != 0) {
+			currentDims.set(
+				Origin::TOP_LEFT,
+				glyphX + (int) (glyph->OffsetX * scale),
+				-lineTop - (int) (glyph->OffsetY * scale),
+				(unsigned int) (glyph->Width * scale),
+				(unsigned int) (glyph->Height * scale)
+			);
+
+			quads_.emplace_back();
+			quads_.back().set(currentDims, glyph->Uv, color_);
+
+			quadTextureIDs_.push_back(glyph->TextureID);
+			quadGaps_.push_back(lineGaps);
+		}
+
+		penX = glyphX + (int) ((glyph->Advance + font.letterSpacing_) * scale);
+
+		previousGlyph = glyph->GlyphIndex;
+		afterSpace = false;
+	}
+
+	finishLine(penX, i, quads_.size(), lineGaps, true);
+
+	height_ = (int) (font.lineHeight_ * scale * lines_.size());
+}
+
+void Evolve::TextLayout::alignLines() {
+	if (options_.Alignment == TextAlignment::LEFT) {
+		return;
+	}
+
+	const int boxWidth = options_.MaxWidth > 0 ? options_.MaxWidth : width_;
+
+	for (size_t i = 0; i < lines_.size(); i++) {
+		TextLine& line = lines_[i];
+		const LineQuads& lineQuads = lineQuads_[i];
+
+		int extraWidth = boxWidth - line.Width;
+
+		if (options_.Alignment == TextAlignment::JUSTIFY) {
+			if (lineQuads.EndsParagraph || lineQuads.NumGaps == 0 || extraWidth <= 0) {
+				continue;
+			}
+
+			// the extra width is spread over the gaps, the words after the nth gap move by n shares
+			for (size_t quad = lineQuads.First; quad < lineQuads.First + lineQuads.Count; quad++) {
+				int shift = extraWidth * quadGaps_[quad] / lineQuads.NumGaps;
+
+				quads_[quad].Left += shift;
+				quads_[quad].Right += shift;
+			}
+
+			line.Width = boxWidth;
+			width_ = std::max(width_, boxWidth);
+			continue;
+		}
+
+		int shift = options_.Alignment == TextAlignment::CENTER ? extraWidth / 2 : extraWidth;
+
+		for (size_t quad = lineQuads.First; quad < lineQuads.First + lineQuads.Count; quad++) {
+			quads_[quad].Left += shift;
+			quads_[quad].Right += shift;
+		}
+
+		line.Left = shift;
+	}
+}
+
+void Evolve::TextLayout::groupQuadsByTexture() {
+	runs_.clear();
+
+	if (quads_.empty()) {
+		return;
+	}
+
+	// most texts fit in one atlas page
+	bool singleTexture = std::all_of(quadTextureIDs_.begin(), quadTextureIDs_.end(),
+		[&](GLuint textureID) { return textureID == quadTextureIDs_[0]; });
+
+	if (singleTexture) {
+		runs_.push_back({ quadTextureIDs_[0], 0, quads_.size() });
+		return;
+	}
+
+	std::vector<size_t> order(quads_.size());
+
+	for (size_t i = 0; i < order.size(); i++) {
+		order[i] = i;
+	}
+
+	std::stable_sort(order.begin(), order.end(),
+		[&](size_t a, size_t b) { return quadTextureIDs_[a] < quadTextureIDs_[b]; });
+
+	sortScratch_.resize(quads_.size());
+
+	for (size_t i = 0; i < order.size(); i++) {
+		sortScratch_[i] = quads_[order[i]];
+
+		GLuint textureID = quadTextureIDs_[order[i]];
+
+		if (runs_.empty() || runs_.back().TextureID != textureID) {
+			runs_.push_back({ textureID, i, 0 });
+		}
+
+		runs_.back().Count++;
+	}
+
+	quads_.swap(sortScratch_);
+}
\ No newline at end of file
@@ -0,0 +1,523 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "../include/Evolve/TextureAtlas.h"
+
+namespace {
+	const char ATLAS_FILE_MAGIC[4] = { 'E', 'V', 'A', 'T' };
+	const uint32_t ATLAS_FILE_VERSION = 1;
+
+	template <typename T>
+	void writeValue(std::ofstream& file, const T& value) {
+		file.write((const char*) &value, sizeof(T));
+	}
+
+	template <typename T>
+	bool readValue(std::ifstream& file, T& value) {
+		return (bool) file.read((char*) &value, sizeof(T));
+	}
+
+	uint64_t bytesLeft(std::ifstream& file, const uint64_t fileSize) {
+		std::streamoff position = file.tellg();
+		return position < 0 || (uint64_t) position > fileSize ? 0 : fileSize - (uint64_t) position;
+	}
+
+	// the nodes must cover the page's width from left to right without gaps, at heights within the page
+	bool isValidSkyline(const std::vector<Evolve::SkylinePacker::Node>& skyline, const int pageWidth, 
+		const int pageHeight) {
+
+		int nextX = 0;
+
+		for (auto& node : skyline) {
+			if (node.X != nextX || node.Width <= 0 || node.Width > pageWidth - node.X || 
+				node.Y < 0 || node.Y > pageHeight) {
+				return false;
+			}
+
+			nextX += node.Width;
+		}
+
+		return nextX == pageWidth;
+	}
+}
+
+Evolve::TextureAtlas::TextureAtlas() {}
+
+Evolve::TextureAtlas::~TextureAtlas() {
+	freeTextureAtlas();
+}
+
+bool Evolve::TextureAtlas::init(const int pageWidth, const int pageHeight, 
+	const unsigned int colorChannels /*= 4*/, const int padding /*= 1*/, const bool keepPixels /*= true*/) {
+
+	if (pageWidth <= 0 || pageHeight <= 0) {
+		EVOLVE_REPORT_ERROR("Invalid atlas page size.", init);
+		return false;
+	}
+
+	if (colorChannels != 1 && colorChannels != 4) {
+		std::string errStr = "Invalid Color channel " + std::to_string(colorChannels) + ".";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), init);
+		return false;
+	}
+
+	if (padding < 0) {
+		EVOLVE_REPORT_ERROR("Atlas padding can't be negative.", init);
+		return false;
+	}
+
+	freeTextureAtlas();
+
+	pageWidth_ = pageWidth;
+	pageHeight_ = pageHeight;
+	colorChannels_ = colorChannels;
+	padding_ = padding;
+	keepPixels_ = keepPixels;
+
+	inited_ = true;
+	return true;
+}
+
+bool Evolve::TextureAtlas::addImage(const std::string& name, const std::string& imagePath, AtlasRegion& region) {
+	if (getRegion(name, region)) {
+		return true;
+	}
+
+	TextureData texture;
+	ImageLoader::LoadTextureFromImage(imagePath, texture, colorChannels_);
+
+	if (texture.data == nullptr) {
+		EVOLVE_REPORT_ERROR("Failed to load the image to add to the atlas.", addImage);
+		return false;
+	}
+
+	// the pixels are copied into the page, so the loader's reference is released right after
+	bool added = addPixels(name, texture.data, texture.width, texture.height, region);
+	ImageLoader::FreeTexture(texture);
+
+	return added;
+}
+
+bool Evolve::TextureAtlas::addPixels(const std::string& name, const unsigned char* pixels, 
+	const int width, const int height, AtlasRegion& region) {
+
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Texture atlas not initialized.", addPixels);
+		return false;
+	}
+
+	if (getRegion(name, region)) {
+		return true;
+	}
+
+	if (!packPixels(pixels, width, height, region)) {
+		std::string errStr = "Failed to add image " + name + " to the atlas.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), addPixels);
+		return false;
+	}
+
+	regions_[name] = region;
+	return true;
+}
+
+bool Evolve::TextureAtlas::addPixels(const unsigned char* pixels, const int width, const int height, 
+	AtlasRegion& region) {
+
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Texture atlas not initialized.", addPixels);
+		return false;
+	}
+
+	return packPixels(pixels, width, height, region);
+}
+
+bool Evolve::TextureAtlas::getRegion(const std::string& name, AtlasRegion& region) const {
+	auto it = regions_.find(name);
+
+	if (it == regions_.end()) {
+		return false;
+	}
+
+	region = it->second;
+	return true;
+}
+
+GLuint Evolve::TextureAtlas::getPageTextureID(const unsigned int page) const {
+	if (page >= pages_.size()) {
+		EVOLVE_REPORT_ERROR("Invalid atlas page used.", getPageTextureID);
+		return 0;
+	}
+
+	return pages_[page].TextureID;
+}
+
+bool Evolve::TextureAtlas::saveToFile(const std::string& filePath) const {
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Texture atlas not initialized.", saveToFile);
+		return false;
+	}
+
+	if (!keepPixels_) {
+		EVOLVE_REPORT_ERROR("The atlas doesn't keep its pixels, it can't be saved.", saveToFile);
+		return false;
+	}
+
+	std::ofstream file(filePath, std::ios::binary);
+
+	if (file.fail()) {
+		std::string errStr = "Failed to open " + filePath + " to save the atlas.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), saveToFile);
+		return false;
+	}
+
+	file.write(ATLAS_FILE_MAGIC, sizeof(ATLAS_FILE_MAGIC));
+	writeValue(file, ATLAS_FILE_VERSION);
+	writeValue(file, (int32_t) pageWidth_);
+	writeValue(file, (int32_t) pageHeight_);
+	writeValue(file, (uint32_t) colorChannels_);
+	writeValue(file, (int32_t) padding_);
+	writeValue(file, (uint32_t) pages_.size());
+
+	for (auto& page : pages_) {
+		// the skyline is saved too so images can still be added after loading
+		auto& skyline = page.Packer.getNodes();
+
+		writeValue(file, (uint32_t) skyline.size());
+		for (auto& node : skyline) {
+			writeValue(file, (int32_t) node.X);
+			writeValue(file, (int32_t) node.Y);
+			writeValue(file, (int32_t) node.Width);
+		}
+
+		file.write((const char*) page.Pixels.data(), page.Pixels.size());
+	}
+
+	writeValue(file, (uint32_t) regions_.size());
+
+	for (auto& it : regions_) {
+		writeValue(file, (uint32_t) it.first.size());
+		file.write(it.first.data(), it.first.size());
+
+		writeValue(file, (uint32_t) it.second.Page);
+		writeValue(file, (int32_t) it.second.X);
+		writeValue(file, (int32_t) it.second.Y);
+		writeValue(file, (int32_t) it.second.Width);
+		writeValue(file, (int32_t) it.second.Height);
+	}
+
+	if (file.fail()) {
+		std::string errStr = "Failed to write the atlas to " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), saveToFile);
+		return false;
+	}
+
+	return true;
+}
+
+bool Evolve::TextureAtlas::loadFromFile(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary);
+
+	if (file.fail()) {
+		std::string errStr = "Failed to open atlas file " + filePath;
+		EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+		return false;
+	}
+
+	char magic[4] = {};
+	uint32_t version = 0;
+	int32_t pageWidth = 0, pageHeight = 0, padding = 0;
+	uint32_t colorChannels = 0, numPages = 0;
+
+	file.read(magic, sizeof(magic));
+	readValue(file, version);
+	readValue(file, pageWidth);
+	readValue(file, pageHeight);
+	readValue(file, colorChannels);
+	readValue(file, padding);
+	readValue(file, numPages);
+
+	if (file.fail() || memcmp(magic, ATLAS_FILE_MAGIC, sizeof(magic)) != 0 || version != ATLAS_FILE_VERSION) {
+		std::string errStr = filePath + " is not a valid atlas file.";
+		EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+		return false;
+	}
+
+	if (!init(pageWidth, pageHeight, colorChannels, padding)) {
+		return false;
+	}
+
+	// every count and length is checked against what's left of the file before anything is allocated
+	std::streamoff headerEnd = file.tellg();
+	file.seekg(0, std::ios::end);
+	uint64_t fileSize = (uint64_t) file.tellg();
+	file.seekg(headerEnd);
+
+	const uint64_t pageSize = (uint64_t) pageWidth_ * pageHeight_ * colorChannels_;
+	const uint64_t nodeSize = sizeof(int32_t) * 3;
+
+	std::string errStr = "Atlas file " + filePath + " is corrupt.";
+
+	for (uint32_t i = 0; i < numPages; i++) {
+		Page page;
+
+		uint32_t numNodes = 0;
+
+		uint64_t left = readValue(file, numNodes) ? bytesLeft(file, fileSize) : 0;
+
+		if (numNodes == 0 || (uint64_t) numNodes * nodeSize > left || pageSize > left - (uint64_t) numNodes * nodeSize) {
+
+			EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+			freeTextureAtlas();
+			return false;
+		}
+
+		std::vector<SkylinePacker::Node> skyline(numNodes);
+
+		for (auto& node : skyline) {
+			int32_t x = 0, y = 0, width = 0;
+			readValue(file, x);
+			readValue(file, y);
+			readValue(file, width);
+			node = { x, y, width };
+		}
+
+		if (file.fail() || !isValidSkyline(skyline, pageWidth_, pageHeight_)) {
+			EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+			freeTextureAtlas();
+			return false;
+		}
+
+		page.Packer.init(pageWidth_, pageHeight_);
+		page.Packer.setNodes(skyline);
+
+		page.Pixels.resize((size_t) pageSize);
+
+		if (!file.read((char*) page.Pixels.data(), page.Pixels.size())) {
+			EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+			freeTextureAtlas();
+			return false;
+		}
+
+		createPageTexture(page);
+		pages_.push_back(std::move(page));
+	}
+
+	uint32_t numRegions = 0;
+
+	if (!readValue(file, numRegions)) {
+		EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+		freeTextureAtlas();
+		return false;
+	}
+
+	for (uint32_t i = 0; i < numRegions; i++) {
+		uint32_t nameLength = 0;
+
+		if (!readValue(file, nameLength) || nameLength > bytesLeft(file, fileSize)) {
+			EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+			freeTextureAtlas();
+			return false;
+		}
+
+		std::string name(nameLength, '\0');
+		file.read(&name[0], nameLength);
+
+		AtlasRegion region;
+		int32_t x = 0, y = 0, width = 0, height = 0;
+
+		readValue(file, region.Page);
+		readValue(file, x);
+		readValue(file, y);
+		readValue(file, width);
+		readValue(file, height);
+
+		if (file.fail() || region.Page >= pages_.size() || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+			width > pageWidth_ - x || height > pageHeight_ - y) {
+
+			EVOLVE_REPORT_ERROR(errStr.c_str(), loadFromFile);
+			freeTextureAtlas();
+			return false;
+		}
+
+		region.TextureID = pages_[region.Page].TextureID;
+		region.X = x;
+		region.Y = y;
+		region.Width = width;
+		region.Height = height;
+		setRegionUv(region);
+
+		regions_[name] = region;
+	}
+
+	return true;
+}
+
+void Evolve::TextureAtlas::freeTextureAtlas() {
+	for (auto& page : pages_) {
+		if (page.TextureID != 0) {
+			glDeleteTextures(1, &page.TextureID);
+		}
+	}
+
+	pages_.clear();
+	regions_.clear();
+	uploadPixels_.clear();
+
+	inited_ = false;
+}
+
+bool Evolve::TextureAtlas::packPixels(const unsigned char* pixels, const int width, const int height, 
+	AtlasRegion& region) {
+
+	int paddedWidth = width + padding_ * 2;
+	int paddedHeight = height + padding_ * 2;
+
+	if (width <= 0 || height <= 0 || paddedWidth > pageWidth_ || paddedHeight > pageHeight_) {
+		EVOLVE_REPORT_ERROR("Image doesn't fit in an atlas page.", packPixels);
+		return false;
+	}
+
+	// the first page with room for the image, else a new page
+	unsigned int pageIndex = 0;
+	int x = 0, y = 0;
+
+	while (pageIndex < pages_.size() && !pages_[pageIndex].Packer.insert(paddedWidth, paddedHeight, x, y)) {
+		pageIndex++;
+	}
+
+	if (pageIndex == pages_.size()) {
+		addPage();
+		pages_[pageIndex].Packer.insert(paddedWidth, paddedHeight, x, y);
+	}
+
+	Page& page = pages_[pageIndex];
+
+	// the image is built with its edge pixels extruded into the padding 
+	// so filtering at the edges doesn't sample the neighbouring images,
+	// in the page's copy if there is one, else in a scratch buffer of just the padded image
+	const int channels = (int) colorChannels_;
+
+	unsigned char* dstPixels = nullptr;
+	int dstRowLength = 0;
+
+	if (keepPixels_) {
+		dstPixels = &page.Pixels[((size_t) y * pageWidth_ + x) * channels];
+		dstRowLength = pageWidth_;
+	}
+	else {
+		uploadPixels_.resize((size_t) paddedWidth * paddedHeight * channels);
+		dstPixels = uploadPixels_.data();
+		dstRowLength = paddedWidth;
+	}
+
+	for (int row = 0; row < paddedHeight; row++) {
+		int srcRow = std::min(std::max(row - padding_, 0), height - 1);
+		unsigned char* dst = dstPixels + (size_t) row * dstRowLength * channels;
+
+		for (int column = 0; column < paddedWidth; column++) {
+			int srcColumn = std::min(std::max(column - padding_, 0), width - 1);
+			memcpy(dst + column * channels, &pixels[((size_t) srcRow * width + srcColumn) * channels], channels);
+		}
+	}
+
+	// upload only the changed rect
+	glBindTexture(GL_TEXTURE_2D, page.TextureID);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, dstRowLength);
+
+	glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, paddedWidth, paddedHeight,
+		colorChannels_ == 1 ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, dstPixels);
+
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	region.TextureID = page.TextureID;
+	region.Page = pageIndex;
+	region.X = x + padding_;
+	region.Y = y + padding_;
+	region.Width = width;
+	region.Height = height;
+	setRegionUv(region);
+
+	return true;
+}
+
+void Evolve::TextureAtlas::addPage() {
+	Page page;
+
+	// without a copy the new texture's contents are undefined, the padding keeps them from being sampled
+	if (keepPixels_) {
+		page.Pixels.assign((size_t) pageWidth_ * pageHeight_ * colorChannels_, 0);
+	}
+
+	page.Packer.init(pageWidth_, pageHeight_);
+
+	createPageTexture(page);
+	pages_.push_back(std::move(page));
+}
+
+void Evolve::TextureAtlas::createPageTexture(Page& page) {
+	glGenTextures(1, &page.TextureID);
+
+	glBindTexture(GL_TEXTURE_2D, page.TextureID);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	const unsigned char* pixels = page.Pixels.empty() ? nullptr : page.Pixels.data();
+
+	if (colorChannels_ == 1) {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, pageWidth_, pageHeight_,
+			0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+	}
+	else {
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pageWidth_, pageHeight_,
+			0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// pages change as images are added, so there are no mipmaps to keep up to date
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Evolve::TextureAtlas::setRegionUv(AtlasRegion& region) const {
+	// the rows of the page go from the top and v goes from the bottom
+	region.Uv.set(
+		(float) region.X / pageWidth_,
+		1.0f - (float) (region.Y + region.Height) / pageHeight_,
+		(float) region.Width / pageWidth_,
+		(float) region.Height / pageHeight_
+	);
+}
\ No newline at end of file
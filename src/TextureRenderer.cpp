@@ -22,37 +22,23 @@ SOFTWARE.
 
 #include "../include/Evolve/TextureRenderer.h"
 
-Evolve::TextureRenderer::Glyph::Glyph(const RectDimension& destRect,
-	const UvDimension& uvRect, GLuint textureID, 
-	const ColorRgba& color, int depth) :
-	
-	textureID_(textureID), depth_(depth)
-{
-	this->textureID_ = textureID;
-
-	// BOTTOM LEFT
-	vertices_[0].setPosition(destRect.getLeft(), destRect.getBottom());
-	vertices_[0].setTextureCoords(uvRect.BottomLeftX, uvRect.BottomLeftY);
-	vertices_[0].setColor(color);
-
-	// BOTTOM RIGHT
-	vertices_[1].setPosition(destRect.getRight(), destRect.getBottom());
-	vertices_[1].setTextureCoords(uvRect.BottomLeftX + uvRect.Width, uvRect.BottomLeftY);
-	vertices_[1].setColor(color);
-
-	// TOP RIGHT
-	vertices_[2].setPosition(destRect.getRight(), destRect.getTop());
-	vertices_[2].setTextureCoords(uvRect.BottomLeftX + uvRect.Width, uvRect.BottomLeftY + uvRect.Height);
-	vertices_[2].setColor(color);
-
-	// TOP LEFT
-	vertices_[3].setPosition(destRect.getLeft(), destRect.getTop());
-	vertices_[3].setTextureCoords(uvRect.BottomLeftX, uvRect.BottomLeftY + uvRect.Height);
-	vertices_[3].setColor(color);
+namespace {
+	constexpr Evolve::StringId IMAGE_SAMPLERS_UNIFORM("u_imageSamplers");
+	constexpr Evolve::StringId IMAGE_SAMPLER_UNIFORM("u_imageSampler");
+
+	void premultiplyColor(Evolve::ColorRgba& color) {
+		color.Red = (GLubyte) ((color.Red * color.Alpha + 127) / 255);
+		color.Green = (GLubyte) ((color.Green * color.Alpha + 127) / 255);
+		color.Blue = (GLubyte) ((color.Blue * color.Alpha + 127) / 255);
+	}
 }
 
-Evolve::TextureRenderer::RenderBatch::RenderBatch(unsigned int offset, unsigned int numIndices, GLuint textureID) :
-	offset_(offset), numIndices_(numIndices), textureID_(textureID) {}
+GLuint Evolve::TextureRenderer::quadIboID_ = 0;
+unsigned int Evolve::TextureRenderer::quadIboCapacity_ = 0;
+unsigned int Evolve::TextureRenderer::quadIboUsers_ = 0;
+
+Evolve::TextureRenderer::RenderBatch::RenderBatch(unsigned int firstGlyph, unsigned int textureOffset) :
+	firstGlyph_(firstGlyph), textureOffset_(textureOffset) {}
 
 Evolve::TextureRenderer::TextureRenderer() {}
 
@@ -60,10 +46,32 @@ Evolve::TextureRenderer::~TextureRenderer() {
 	freeTextureRenderer();
 }
 
-bool Evolve::TextureRenderer::init(const std::string& pathToAssets) {
+bool Evolve::TextureRenderer::init(const std::string& pathToAssets,
+	const TextureBatchingMode batchingMode /*= TextureBatchingMode::SINGLE_TEXTURE*/,
+	const BufferUploadMode uploadMode /*= BufferUploadMode::MAPPED_RING*/) {
 	
-	std::string vertShaderPath = pathToAssets + "/shaders/texture_shader.vert";
-	std::string fragShaderPath = pathToAssets + "/shaders/texture_shader.frag";
+	batchingMode_ = batchingMode;
+	uploadMode_ = uploadMode;
+
+	std::string vertShaderName = "texture_shader";
+	std::string fragShaderName = "texture_shader";
+
+	if (batchingMode_ != TextureBatchingMode::SINGLE_TEXTURE) {
+		vertShaderName = batchingMode_ == TextureBatchingMode::INSTANCED ? 
+			"instanced_texture_shader" : "multi_texture_shader";
+		fragShaderName = "multi_texture_shader";
+
+		GLint maxTextureUnits = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+
+		maxTextureSlots_ = std::min((unsigned int) maxTextureUnits, MAX_TEXTURE_SLOTS);
+	}
+	else {
+		maxTextureSlots_ = 1;
+	}
+
+	std::string vertShaderPath = pathToAssets + "/shaders/" + vertShaderName + ".vert";
+	std::string fragShaderPath = pathToAssets + "/shaders/" + fragShaderName + ".frag";
 
 	if (!defaultShader_.compileAndLinkShaders(
 		vertShaderPath,
@@ -88,13 +96,12 @@ void Evolve::TextureRenderer::begin() {
 	}
 
 	glyphs_.clear();
-	glyphPointers_.clear();
+	glyphSortData_.clear();
+	sortEntries_.clear();
 	renderBatches_.clear();
+	batchTextureIDs_.clear();
 
-	if (!iboIDs_.empty()) {
-		glDeleteBuffers((GLsizei) iboIDs_.size(), iboIDs_.data());
-		iboIDs_.clear();
-	}
+	stats_.reset();
 }
 
 void Evolve::TextureRenderer::draw(const RectDimension& destRect, const UvDimension& uvRect,
@@ -105,41 +112,55 @@ void Evolve::TextureRenderer::draw(const RectDimension& destRect, const UvDimens
 		return;
 	}
 
-	glyphs_.emplace_back(destRect, uvRect, textureID, color, depth);
+	glyphs_.emplace_back();
+	glyphs_.back().set(destRect, uvRect, color);
+	glyphSortData_.push_back({ textureID, depth });
+
+	if (blendMode_ == TextureBlendMode::PREMULTIPLIED_ALPHA) {
+		premultiplyColor(glyphs_.back().Color);
+	}
 }
 
-void Evolve::TextureRenderer::end(const GlyphSortType& sortType /*= GlyphSortType::BY_TEXTURE_ID_INCREMENTAL*/) {
+void Evolve::TextureRenderer::draw(const SpriteInstance* sprites, const size_t numSprites, GLuint textureID,
+	const int offsetX /*= 0*/, const int offsetY /*= 0*/, int depth /*= 0*/) {
 
 	if (!inited_) {
-		EVOLVE_REPORT_ERROR("Texture renderer not initialized.", begin);
+		EVOLVE_REPORT_ERROR("Texture renderer not initialized.", draw);
 		return;
 	}
 
-	if (!glyphs_.empty()) {
-		glyphPointers_.resize(glyphs_.size());
+	size_t firstGlyph = glyphs_.size();
+
+	glyphs_.insert(glyphs_.end(), sprites, sprites + numSprites);
+	glyphSortData_.resize(glyphSortData_.size() + numSprites, { textureID, depth });
+
+	if (offsetX != 0 || offsetY != 0) {
+		for (size_t i = firstGlyph; i < glyphs_.size(); i++) {
+			SpriteInstance& glyph = glyphs_[i];
 
-		for (size_t i = 0; i < glyphPointers_.size(); i++) {
-			glyphPointers_[i] = &glyphs_[i];
+			glyph.Left += offsetX;
+			glyph.Right += offsetX;
+			glyph.Bottom += offsetY;
+			glyph.Top += offsetY;
 		}
+	}
 
-		switch (sortType) {
-		
-		case GlyphSortType::BY_TEXTURE_ID_INCREMENTAL:
-			std::stable_sort(glyphPointers_.begin(), glyphPointers_.end(), compareByTextureIdIncremental);
-			break;
+	if (blendMode_ == TextureBlendMode::PREMULTIPLIED_ALPHA) {
+		for (size_t i = firstGlyph; i < glyphs_.size(); i++) {
+			premultiplyColor(glyphs_[i].Color);
+		}
+	}
+}
 
-		case GlyphSortType::BY_TEXTURE_ID_DECREMENTAL:
-			std::stable_sort(glyphPointers_.begin(), glyphPointers_.end(), compareByTextureIdDecremental);
-			break;
+void Evolve::TextureRenderer::end(const GlyphSortType& sortType /*= GlyphSortType::BY_TEXTURE_ID_INCREMENTAL*/) {
 
-		/*case GlyphSortType::BY_DEPTH_INCREMENTAL:
-			std::stable_sort(glyphPointers_.begin(), glyphPointers_.end(), compareByDepthIncremental);
-			break;
+	if (!inited_) {
+		EVOLVE_REPORT_ERROR("Texture renderer not initialized.", begin);
+		return;
+	}
 
-		case GlyphSortType::BY_DEPTH_DECREMENTAL:
-			std::stable_sort(glyphPointers_.begin(), glyphPointers_.end(), compareByDepthDecremental);
-			break;*/
-		}
+	if (!glyphs_.empty()) {
+		sortGlyphs(sortType);
 
 		setupRenderBatches();
 	}
@@ -163,27 +184,95 @@ void Evolve::TextureRenderer::renderTextures(Camera& camera, GlslProgram* shader
 
 	camera.sendMatrixDataToShader(*currentShader_);
 
-	glActiveTexture(GL_TEXTURE0);
-	GLint samplerLoc = currentShader_->getUniformLocation("u_imageSampler");
-	glUniform1i(samplerLoc, 0);
+	if (blendMode_ == TextureBlendMode::PREMULTIPLIED_ALPHA) {
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	if (batchingMode_ != TextureBatchingMode::SINGLE_TEXTURE) {
+		GLint textureUnits[MAX_TEXTURE_SLOTS] = {};
+
+		for (unsigned int i = 0; i < MAX_TEXTURE_SLOTS; i++) {
+			textureUnits[i] = i;
+		}
+
+		GLint samplersLoc = currentShader_->getUniformLocation(IMAGE_SAMPLERS_UNIFORM);
+		glUniform1iv(samplersLoc, maxTextureSlots_, textureUnits);
+	}
+	else {
+		glActiveTexture(GL_TEXTURE0);
+		GLint samplerLoc = currentShader_->getUniformLocation(IMAGE_SAMPLER_UNIFORM);
+		glUniform1i(samplerLoc, 0);
+	}
+
+	stats_.NumTextureBinds = 0;
 
 	if (!renderBatches_.empty()) {
 		glBindVertexArray(vaoID_);
 
+		const bool instanced = batchingMode_ == TextureBatchingMode::INSTANCED;
+
+		// the data of this frame may be in any region of the vbo
+		if (!instanced) {
+			setVertexAttribPointers(uploadOffset_);
+		}
+
+		// the texture currently bound to each slot, to skip rebinding it for the next batch
+		GLuint boundTextures[MAX_TEXTURE_SLOTS] = {};
+
 		for (auto& batch : renderBatches_) {
-			glBindTexture(GL_TEXTURE_2D, batch.textureID_);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.iboID_);
-			glDrawElements(GL_TRIANGLES, batch.numIndices_, GL_UNSIGNED_INT, nullptr);
+
+			for (unsigned int slot = 0; slot < batch.numTextures_; slot++) {
+				GLuint textureID = batchTextureIDs_[batch.textureOffset_ + slot];
+
+				if (boundTextures[slot] != textureID) {
+					glActiveTexture(GL_TEXTURE0 + slot);
+					glBindTexture(GL_TEXTURE_2D, textureID);
+
+					boundTextures[slot] = textureID;
+					stats_.NumTextureBinds++;
+				}
+			}
+
+			if (instanced) {
+				// there's no base instance in gl 3.3, so the instance attributes are pointed at the batch
+				setVertexAttribPointers(uploadOffset_ + batch.firstGlyph_ * sizeof(SpriteInstance));
+				glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, batch.numGlyphs_);
+			}
+			else {
+				glDrawElements(GL_TRIANGLES, batch.numGlyphs_ * 6, GL_UNSIGNED_INT,
+					(void*) (batch.firstGlyph_ * 6 * sizeof(GLuint)));
+			}
 		}
 
 		glBindVertexArray(0);
+
+		if (uploadMode_ == BufferUploadMode::MAPPED_RING) {
+			// the region of this frame can be written again once the gpu is done with these draws
+			if (regionFences_[currentRegion_] != nullptr) {
+				glDeleteSync(regionFences_[currentRegion_]);
+			}
+
+			regionFences_[currentRegion_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
 		
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		for (unsigned int slot = 0; slot < maxTextureSlots_; slot++) {
+			if (boundTextures[slot] != 0) {
+				glActiveTexture(GL_TEXTURE0 + slot);
+				glBindTexture(GL_TEXTURE_2D, 0);
+			}
+		}
+
+		glActiveTexture(GL_TEXTURE0);
 		
 		glDisableVertexAttribArray(0);
 		glDisableVertexAttribArray(1);
 		glDisableVertexAttribArray(2);
+		glDisableVertexAttribArray(3);
+	}
+
+	// back to the blending the window set up
+	if (blendMode_ == TextureBlendMode::PREMULTIPLIED_ALPHA) {
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	}
 
 	currentShader_->unuseProgram();
@@ -195,13 +284,23 @@ void Evolve::TextureRenderer::freeTextureRenderer() {
 		defaultShader_.freeProgram();
 	}
 
-	if (!iboIDs_.empty()) {
-		glDeleteBuffers((GLsizei) iboIDs_.size(), iboIDs_.data());
+	if (vaoID_ != 0) {
+		quadIboUsers_--;
+
+		if (quadIboUsers_ == 0 && quadIboID_ != 0) {
+			glDeleteBuffers(1, &quadIboID_);
+			quadIboID_ = 0;
+			quadIboCapacity_ = 0;
+		}
 	}
 
+	deleteRegionFences();
+
 	if (vboID_ != 0) {
 		glDeleteBuffers(1, &vboID_);
 		vboID_ = 0;
+		vboCapacity_ = 0;
+		uploadOffset_ = 0;
 	}
 	
 	if (vaoID_ != 0) {
@@ -219,120 +318,374 @@ void Evolve::TextureRenderer::createVao() {
 		glGenBuffers(1, &vboID_);
 	}
 
+	if (quadIboID_ == 0) {
+		glGenBuffers(1, &quadIboID_);
+	}
+
+	quadIboUsers_++;
+
 	glBindVertexArray(vaoID_);
 
 	glBindBuffer(GL_ARRAY_BUFFER, vboID_);
 
+	// the element buffer binding is part of the vao state
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIboID_);
+
 	glEnableVertexAttribArray(0);
 	glEnableVertexAttribArray(1);
 	glEnableVertexAttribArray(2);
+	glEnableVertexAttribArray(3);
+
+	if (batchingMode_ == TextureBatchingMode::INSTANCED) {
+		for (GLuint attrib = 0; attrib < 4; attrib++) {
+			glVertexAttribDivisor(attrib, 1);
+		}
+	}
 
-	glVertexAttribPointer(0, 2, GL_INT, GL_FALSE, sizeof(Vertex2D), (void*) offsetof(Vertex2D, Position));
-	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex2D), (void*) offsetof(Vertex2D, Color));
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), (void*) offsetof(Vertex2D, TextureCoords));
+	setVertexAttribPointers(0);
 
 	glBindVertexArray(0);
 }
 
-void Evolve::TextureRenderer::setupRenderBatches() {
+void Evolve::TextureRenderer::setVertexAttribPointers(GLintptr offset) {
 
-	if (!glyphPointers_.empty()) {
+	// expects the vao to be bound
+	glBindBuffer(GL_ARRAY_BUFFER, vboID_);
 
-		{
-			// setup the vbo and buffer vertex data
-			std::vector<Vertex2D> vertices;
-			vertices.resize(glyphPointers_.size() * 4);
+	if (batchingMode_ == TextureBatchingMode::INSTANCED) {
+		glVertexAttribPointer(0, 4, GL_INT, GL_FALSE, sizeof(SpriteInstance),
+			(void*) (offset + offsetof(SpriteInstance, Left)));
+		glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance),
+			(void*) (offset + offsetof(SpriteInstance, Color)));
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance),
+			(void*) (offset + offsetof(SpriteInstance, Uv)));
+		glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(SpriteInstance),
+			(void*) (offset + offsetof(SpriteInstance, TextureSlot)));
+		return;
+	}
 
-			unsigned int currentVertex = 0;
+	glVertexAttribPointer(0, 2, GL_INT, GL_FALSE, sizeof(Vertex2D), 
+		(void*) (offset + offsetof(Vertex2D, Position)));
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex2D), 
+		(void*) (offset + offsetof(Vertex2D, Color)));
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex2D), 
+		(void*) (offset + offsetof(Vertex2D, TextureCoords)));
+	glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(Vertex2D), 
+		(void*) (offset + offsetof(Vertex2D, TextureSlot)));
+}
 
-			for (auto& glyph : glyphPointers_) {
-				for (int vertex = 0; vertex < 4; vertex++) {
-					vertices[currentVertex++] = glyph->vertices_[vertex];
-				}
-			}
+void Evolve::TextureRenderer::setupRenderBatches() {
 
-			glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+	if (!sortEntries_.empty()) {
 
-			glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex2D), nullptr, GL_DYNAMIC_DRAW);
+		// setup the render batches and gather the glyphs in sorted order in one pass,
+		// drawn instanced every glyph is one record, otherwise four vertices drawn with the shared quad ibo
+		const bool instanced = batchingMode_ == TextureBatchingMode::INSTANCED;
 
-			glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex2D), vertices.data());
+		const size_t numGlyphs = sortEntries_.size();
+		const GLsizeiptr uploadSize = instanced ? 
+			numGlyphs * sizeof(SpriteInstance) : numGlyphs * 4 * sizeof(Vertex2D);
 
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		if (!instanced) {
+			reserveQuadIndices((unsigned int) numGlyphs);
 		}
 
+		// this may point into mapped gpu memory, so it's only written to, sequentially
+		void* uploadDestination = beginUpload(uploadSize);
 
-		{
-			// Setup render batches and the ibo
-			std::vector<GLuint> vertexIndices;
-			vertexIndices.resize(glyphPointers_.size() * 6);
+		SpriteInstance* instances = (SpriteInstance*) uploadDestination;
+		Vertex2D* vertices = (Vertex2D*) uploadDestination;
 
-			unsigned int numIndices = 6;
-			unsigned int curentIndex = 0;
-			unsigned int currentVertex = 0;
+		GLuint previousTextureID = 0;
 
-			renderBatches_.emplace_back(curentIndex, numIndices, glyphPointers_[0]->textureID_);
-			addIndicesToBuffer(vertexIndices, curentIndex, currentVertex);
+		for (size_t i = 0; i < numGlyphs; i++) {
+			const uint32_t glyphIndex = sortEntries_[i].Index;
+			GLuint textureID = glyphSortData_[glyphIndex].TextureID;
 
-			for (size_t i = 1; i < glyphPointers_.size(); i++) {
+			if (i == 0 || textureID != previousTextureID) {
+				stats_.NumTextureChanges++;
+			}
+
+			previousTextureID = textureID;
+
+			// look for the texture among the ones already bound for the current batch
+			GLuint slot = 0;
+			bool foundSlot = false;
 
-				if (glyphPointers_[i]->textureID_ == glyphPointers_[i - 1]->textureID_) {
-					renderBatches_.back().numIndices_ += 6;
+			if (!renderBatches_.empty()) {
+				RenderBatch& batch = renderBatches_.back();
+
+				for (slot = 0; slot < batch.numTextures_; slot++) {
+					if (batchTextureIDs_[batch.textureOffset_ + slot] == textureID) {
+						foundSlot = true;
+						break;
+					}
 				}
-				else {
-					renderBatches_.emplace_back(curentIndex, numIndices, glyphPointers_[i]->textureID_);
+			}
+
+			if (!foundSlot) {
+				if (renderBatches_.empty() || renderBatches_.back().numTextures_ == maxTextureSlots_) {
+					renderBatches_.emplace_back((unsigned int) i, (unsigned int) batchTextureIDs_.size());
 				}
 
-				addIndicesToBuffer(vertexIndices, curentIndex, currentVertex);
+				RenderBatch& batch = renderBatches_.back();
+
+				slot = batch.numTextures_++;
+				batchTextureIDs_.push_back(textureID);
 			}
 
-			iboIDs_.resize(renderBatches_.size());
+			renderBatches_.back().numGlyphs_++;
+
+			SpriteInstance glyph = glyphs_[glyphIndex];
+			glyph.TextureSlot = slot;
+
+			if (instanced) {
+				instances[i] = glyph;
+			}
+			else {
+				writeQuadVertices(glyph, &vertices[i * 4]);
+			}
+		}
 
-			glGenBuffers((GLsizei) iboIDs_.size(), iboIDs_.data());
+		endUpload(uploadSize);
 
-			for (size_t i = 0; i < iboIDs_.size(); i++) {
+		stats_.NumVertices = instanced ? numGlyphs : numGlyphs * 4;
+		stats_.NumDrawCalls = (unsigned int) renderBatches_.size();
+	}
+}
 
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iboIDs_[i]);
+void Evolve::TextureRenderer::writeQuadVertices(const SpriteInstance& glyph, Vertex2D* destination) {
 
-				glBufferData(GL_ELEMENT_ARRAY_BUFFER, renderBatches_[i].numIndices_ * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+	Vertex2D vertex;
+	vertex.setColor(glyph.Color);
+	vertex.setTextureSlot(glyph.TextureSlot);
 
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, renderBatches_[i].numIndices_ * sizeof(GLuint), &vertexIndices[renderBatches_[i].offset_]);
+	const UvDimension& uv = glyph.Uv;
 
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	// BOTTOM LEFT
+	vertex.setPosition(glyph.Left, glyph.Bottom);
+	vertex.setTextureCoords(uv.BottomLeftX, uv.BottomLeftY);
+	destination[0] = vertex;
 
-				renderBatches_[i].iboID_ = iboIDs_[i];
-			}
+	// BOTTOM RIGHT
+	vertex.setPosition(glyph.Right, glyph.Bottom);
+	vertex.setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY);
+	destination[1] = vertex;
+
+	// TOP RIGHT
+	vertex.setPosition(glyph.Right, glyph.Top);
+	vertex.setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY + uv.Height);
+	destination[2] = vertex;
+
+	// TOP LEFT
+	vertex.setPosition(glyph.Left, glyph.Top);
+	vertex.setTextureCoords(uv.BottomLeftX, uv.BottomLeftY + uv.Height);
+	destination[3] = vertex;
+}
+
+void* Evolve::TextureRenderer::beginUpload(GLsizeiptr size) {
+
+	if (uploadMode_ == BufferUploadMode::MAPPED_RING) {
+		glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+
+		GLsizeiptr regionSize = vboCapacity_ / NUM_RING_REGIONS;
+
+		if (size > regionSize) {
+			// grow geometrically, the regions are kept 16 byte aligned
+			regionSize = (std::max(size, regionSize * 2) + 15) & ~(GLsizeiptr) 15;
+			vboCapacity_ = regionSize * NUM_RING_REGIONS;
+
+			// the old storage is orphaned, nothing in the new one is in use by the gpu
+			glBufferData(GL_ARRAY_BUFFER, vboCapacity_, nullptr, GL_STREAM_DRAW);
+			deleteRegionFences();
+		}
+
+		currentRegion_ = (currentRegion_ + 1) % NUM_RING_REGIONS;
+		waitForRegion(currentRegion_);
+
+		uploadOffset_ = currentRegion_ * regionSize;
+
+		void* destination = glMapBufferRange(GL_ARRAY_BUFFER, uploadOffset_, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+		if (destination != nullptr) {
+			// the vbo stays bound until endUpload()
+			uploadMapped_ = true;
+			return destination;
 		}
+
+		EVOLVE_REPORT_ERROR("Failed to map the vertex buffer, using glBufferSubData instead.", beginUpload);
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
+
+	uploadMapped_ = false;
+
+	uploadScratch_.resize(size);
+	return uploadScratch_.data();
 }
 
-void Evolve::TextureRenderer::addIndicesToBuffer(std::vector<GLuint>& indices,
-	unsigned int& currentIndex, unsigned int& currentVertex) {
-	
-	// first triangle
-	indices[currentIndex++] = currentVertex; // bottom left
-	indices[currentIndex++] = currentVertex + 1; // bottom right
-	indices[currentIndex++] = currentVertex + 2; // top right
+void Evolve::TextureRenderer::endUpload(GLsizeiptr size) {
+
+	if (uploadMapped_) {
+		if (glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE) {
+			EVOLVE_REPORT_ERROR("Vertex buffer contents got corrupted while mapped.", endUpload);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		uploadMapped_ = false;
+	}
+	else if (uploadMode_ == BufferUploadMode::MAPPED_RING) {
+		// mapping failed, the region is still unused by the gpu
+		glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+		glBufferSubData(GL_ARRAY_BUFFER, uploadOffset_, size, uploadScratch_.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+	else {
+		uploadOffset_ = 0;
+		uploadVertexData(uploadScratch_.data(), size);
+	}
+}
+
+void Evolve::TextureRenderer::waitForRegion(unsigned int region) {
+
+	if (regionFences_[region] == nullptr) {
+		return;
+	}
+
+	// with three regions in flight this has normally been signaled long ago
+	GLenum result = GL_TIMEOUT_EXPIRED;
+
+	while (result == GL_TIMEOUT_EXPIRED) {
+		result = glClientWaitSync(regionFences_[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
 
-	// second triangle
-	indices[currentIndex++] = currentVertex; // bottom left
-	indices[currentIndex++] = currentVertex + 3; // top left
-	indices[currentIndex++] = currentVertex + 2; // top right
+	glDeleteSync(regionFences_[region]);
+	regionFences_[region] = nullptr;
+}
 
-	currentVertex += 4;
+void Evolve::TextureRenderer::deleteRegionFences() {
+	for (auto& fence : regionFences_) {
+		if (fence != nullptr) {
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
 }
 
-bool Evolve::TextureRenderer::compareByTextureIdIncremental(Glyph* a, Glyph* b) {
-	return (a->textureID_ < b->textureID_);
+void Evolve::TextureRenderer::uploadVertexData(const void* data, GLsizeiptr size) {
+
+	glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+
+	if (uploadMode_ == BufferUploadMode::STATIC) {
+		// rarely uploaded, so it's stored in exactly the size needed
+		vboCapacity_ = size;
+
+		glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return;
+	}
+
+	if (size > vboCapacity_) {
+		// grow geometrically so the storage is reallocated only a few times
+		vboCapacity_ = std::max(size, vboCapacity_ * 2);
+	}
+
+	// respecifying the whole storage with no data orphans the old one, 
+	// so the driver doesn't have to wait for the previous frame's draw calls to finish
+	glBufferData(GL_ARRAY_BUFFER, vboCapacity_, nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-bool Evolve::TextureRenderer::compareByTextureIdDecremental(Glyph* a, Glyph* b) {
-	return (a->textureID_ > b->textureID_);
+void Evolve::TextureRenderer::reserveQuadIndices(unsigned int numQuads) {
+
+	if (numQuads <= quadIboCapacity_) {
+		return;
+	}
+
+	quadIboCapacity_ = std::max(numQuads, quadIboCapacity_ * 2);
+
+	std::vector<GLuint> indices(quadIboCapacity_ * 6);
+
+	unsigned int currentIndex = 0;
+
+	for (GLuint vertex = 0; vertex < quadIboCapacity_ * 4; vertex += 4) {
+		// first triangle
+		indices[currentIndex++] = vertex; // bottom left
+		indices[currentIndex++] = vertex + 1; // bottom right
+		indices[currentIndex++] = vertex + 2; // top right
+
+		// second triangle
+		indices[currentIndex++] = vertex; // bottom left
+		indices[currentIndex++] = vertex + 3; // top left
+		indices[currentIndex++] = vertex + 2; // top right
+	}
+
+	// the buffer is shared by every renderer's vao, bind it through ours
+	glBindVertexArray(vaoID_);
+
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
 }
 
-//bool Evolve::TextureRenderer::compareByDepthIncremental(Glyph* a, Glyph* b) {
-//	return (a->depth_ < b->depth_);
-//}
-//
-//bool Evolve::TextureRenderer::compareByDepthDecremental(Glyph* a, Glyph* b) {
-//	return (a->depth_ > b->depth_);
-//}
\ No newline at end of file
+void Evolve::TextureRenderer::sortGlyphs(const GlyphSortType& sortType) {
+
+	bool byDepth = false, byTexture = false, decremental = false;
+
+	switch (sortType) {
+
+	case GlyphSortType::BY_TEXTURE_ID_INCREMENTAL:
+		byTexture = true;
+		break;
+
+	case GlyphSortType::BY_TEXTURE_ID_DECREMENTAL:
+		byTexture = true;
+		decremental = true;
+		break;
+
+	case GlyphSortType::BY_DEPTH_INCREMENTAL:
+		byDepth = true;
+		break;
+
+	case GlyphSortType::BY_DEPTH_DECREMENTAL:
+		byDepth = true;
+		decremental = true;
+		break;
+
+	case GlyphSortType::BY_DEPTH_AND_TEXTURE_ID_INCREMENTAL:
+		byDepth = true;
+		byTexture = true;
+		break;
+
+	case GlyphSortType::BY_DEPTH_AND_TEXTURE_ID_DECREMENTAL:
+		byDepth = true;
+		byTexture = true;
+		decremental = true;
+		break;
+	}
+
+	// pack the depth into the high and the texture id into the low 32 bits of the key
+	// flipping the sign bit of the depth orders negative depths before positive ones
+	// inverting the whole key sorts decrementally while keeping the sort stable
+	sortEntries_.resize(glyphSortData_.size());
+
+	for (size_t i = 0; i < glyphSortData_.size(); i++) {
+		uint64_t key = 0;
+
+		if (byDepth) {
+			key |= (uint64_t) ((uint32_t) glyphSortData_[i].Depth ^ 0x80000000u) << 32;
+		}
+
+		if (byTexture) {
+			key |= glyphSortData_[i].TextureID;
+		}
+
+		sortEntries_[i].Key = decremental ? ~key : key;
+		sortEntries_[i].Index = (uint32_t) i;
+	}
+
+	radixSortEntries(sortEntries_, sortScratch_);
+}
\ No newline at end of file
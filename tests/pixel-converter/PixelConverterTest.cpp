@@ -0,0 +1,151 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// checks the PixelConverter kernels against plain per pixel loops
+// build it together with the engine sources, it needs no window or gl context,
+// build it once per instruction set (e.g. -mavx2, -msse2 and -mno-sse2 on x86) to cover every path
+// returns 0 when every kernel matches
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/PixelConverter.h"
+
+namespace {
+	// lengths around the 4, 8 and 16 pixel vector widths, so the scalar tails are covered too
+	const size_t TEST_LENGTHS[] = { 0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 63, 1000 };
+
+	// the orders with sse2 fast paths, and one that falls back to the scalar loop
+	const unsigned char SWIZZLE_ORDERS[][4] = {
+		{ 2, 1, 0, 3 },
+		{ 3, 0, 1, 2 },
+		{ 1, 2, 3, 0 },
+		{ 3, 2, 1, 0 },
+		{ 0, 1, 2, 3 }
+	};
+
+	int numFailures = 0;
+
+	std::vector<unsigned char> makePixels(const size_t numPixels, unsigned int seed) {
+		std::vector<unsigned char> pixels(numPixels * 4);
+
+		for (auto& channel : pixels) {
+			seed = seed * 1664525u + 1013904223u;
+			channel = (unsigned char) (seed >> 24);
+		}
+
+		// the extremes of alpha and the color channels
+		if (numPixels >= 2) {
+			pixels[0] = 255; pixels[1] = 0; pixels[2] = 128; pixels[3] = 255;
+			pixels[4] = 255; pixels[5] = 255; pixels[6] = 1; pixels[7] = 0;
+		}
+
+		return pixels;
+	}
+
+	void check(const bool passed, const char* kernel, const size_t numPixels) {
+		if (!passed) {
+			printf("FAILED: %s with %zu pixels\n", kernel, numPixels);
+			numFailures++;
+		}
+	}
+
+	void testPremultiplyAlpha(const size_t numPixels) {
+		std::vector<unsigned char> pixels = makePixels(numPixels, 1);
+		std::vector<unsigned char> expected = pixels;
+
+		for (size_t i = 0; i < numPixels; i++) {
+			unsigned int alpha = expected[i * 4 + 3];
+
+			for (int c = 0; c < 3; c++) {
+				expected[i * 4 + c] = (unsigned char) ((expected[i * 4 + c] * alpha * 2 + 255) / 510);
+			}
+		}
+
+		Evolve::PixelConverter::PremultiplyAlpha(pixels.data(), numPixels);
+		check(pixels == expected, "PremultiplyAlpha", numPixels);
+	}
+
+	void testPackRgb565(const size_t numPixels) {
+		std::vector<unsigned char> pixels = makePixels(numPixels, 2);
+		std::vector<uint16_t> expected(numPixels), packed(numPixels);
+
+		for (size_t i = 0; i < numPixels; i++) {
+			const unsigned char* pixel = &pixels[i * 4];
+			expected[i] = (uint16_t) ((pixel[0] >> 3) << 11 | (pixel[1] >> 2) << 5 | pixel[2] >> 3);
+		}
+
+		Evolve::PixelConverter::PackRgb565(pixels.data(), packed.data(), numPixels);
+		check(packed == expected, "PackRgb565", numPixels);
+	}
+
+	void testPackRgba4444(const size_t numPixels) {
+		std::vector<unsigned char> pixels = makePixels(numPixels, 3);
+		std::vector<uint16_t> expected(numPixels), packed(numPixels);
+
+		for (size_t i = 0; i < numPixels; i++) {
+			const unsigned char* pixel = &pixels[i * 4];
+			expected[i] = (uint16_t) ((pixel[0] >> 4) << 12 | (pixel[1] >> 4) << 8 | (pixel[2] >> 4) << 4 | pixel[3] >> 4);
+		}
+
+		Evolve::PixelConverter::PackRgba4444(pixels.data(), packed.data(), numPixels);
+		check(packed == expected, "PackRgba4444", numPixels);
+	}
+
+	void testSwizzleChannels(const size_t numPixels, const unsigned char order[4]) {
+		std::vector<unsigned char> pixels = makePixels(numPixels, 4);
+		std::vector<unsigned char> expected = pixels;
+
+		for (size_t i = 0; i < numPixels; i++) {
+			for (int c = 0; c < 4; c++) {
+				expected[i * 4 + c] = pixels[i * 4 + order[c]];
+			}
+		}
+
+		Evolve::PixelConverter::SwizzleChannels(pixels.data(), numPixels, order);
+
+		char kernel[64];
+		snprintf(kernel, sizeof(kernel), "SwizzleChannels {%d, %d, %d, %d}", order[0], order[1], order[2], order[3]);
+		check(pixels == expected, kernel, numPixels);
+	}
+}
+
+int main() {
+	printf("testing the %s kernels\n", Evolve::PixelConverter::GetSimdName());
+
+	for (size_t numPixels : TEST_LENGTHS) {
+		testPremultiplyAlpha(numPixels);
+		testPackRgb565(numPixels);
+		testPackRgba4444(numPixels);
+
+		for (auto& order : SWIZZLE_ORDERS) {
+			testSwizzleChannels(numPixels, order);
+		}
+	}
+
+	if (numFailures > 0) {
+		printf("%d checks failed\n", numFailures);
+		return 1;
+	}
+
+	printf("all checks passed\n");
+	return 0;
+}
\ No newline at end of file
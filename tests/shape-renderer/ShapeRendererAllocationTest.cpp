@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// checks that ShapeRenderer doesn't allocate per shape once its arenas have grown to a frame's needs
+// every operator new is counted while a second frame of the same shapes is drawn
+// build it together with the engine sources, it opens a window for the gl context the renderer needs
+//
+// usage: shape-renderer-allocation-test [path to engine-assets]
+// returns 0 when the second frame made no allocation
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/Camera.h"
+#include "../../include/Evolve/ShapeRenderer.h"
+
+#include <new>
+
+namespace {
+	bool countingAllocations = false;
+	size_t numAllocations = 0;
+
+	void* allocate(size_t size) {
+		if (countingAllocations) {
+			numAllocations++;
+		}
+
+		void* memory = malloc(size == 0 ? 1 : size);
+
+		if (memory == nullptr) {
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+
+	void drawShapes(Evolve::ShapeRenderer& renderer) {
+		const Evolve::ColorRgba color = { 255, 128, 0, 255 };
+
+		const Evolve::Position2D polygon[] = { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 50, 40 }, { 0, 100 } };
+		const Evolve::Position2D polyline[] = { { 0, 0 }, { 50, 80 }, { 100, 0 }, { 150, 80 } };
+
+		for (int i = 0; i < 1000; i++) {
+			int x = (i * 37) % 1200, y = (i * 53) % 700;
+
+			renderer.drawTriangle({ x, y }, { x + 20, y }, { x + 10, y + 20 }, color, i % 4);
+			renderer.drawRectangle(Evolve::RectDimension(Evolve::Origin::BOTTOM_LEFT, x, y, 30, 20), color, i % 4);
+			renderer.drawCircle({ x, y }, 1 + i % 200, color, i % 4);
+			renderer.drawConvexPolygon(polygon, 3, color, i % 4);
+			renderer.drawPolygon(polygon, 5, color, i % 4);
+			renderer.drawPolyline(polyline, 4, 3.0f, color, i % 4);
+			renderer.drawSmoothCircle({ x, y }, 10.0f, color, i % 4);
+			renderer.drawRing({ x, y }, 10.0f, 2.0f, color, i % 4);
+			renderer.drawLine({ x, y }, { x + 40, y + 10 }, 2.0f, color, i % 4, true);
+		}
+	}
+}
+
+void* operator new(size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](size_t size) {
+	return allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+	free(memory);
+}
+
+int main(int argc, char** argv) {
+	std::string pathToAssets = argc > 1 ? argv[1] : "engine-assets";
+
+	Evolve::Window window;
+
+	if (!window.init("ShapeRenderer allocation test", false, 1280, 720, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	Evolve::Camera camera;
+	camera.init({ 1280, 720 });
+
+	Evolve::ShapeRenderer renderer;
+
+	if (!renderer.init(pathToAssets)) {
+		return 1;
+	}
+
+	int result = 0;
+
+	for (int frame = 0; frame < 2; frame++) {
+		renderer.begin();
+
+		// the first frame grows the arenas and fills the circle table cache
+		countingAllocations = true;
+		drawShapes(renderer);
+		countingAllocations = false;
+
+		printf("frame %d: %zu allocations while drawing\n", frame, numAllocations);
+
+		if (frame == 1 && numAllocations > 0) {
+			result = 1;
+		}
+
+		numAllocations = 0;
+
+		countingAllocations = true;
+		renderer.end();
+		countingAllocations = false;
+
+		printf("frame %d: %zu allocations in end()\n", frame, numAllocations);
+
+		if (frame == 1 && numAllocations > 0) {
+			result = 1;
+		}
+
+		numAllocations = 0;
+
+		window.clearScreen(GL_COLOR_BUFFER_BIT);
+		renderer.renderShapes(camera);
+		window.swapBuffer();
+	}
+
+	renderer.freeShapeRenderer();
+	window.deleteWindow();
+
+	printf(result == 0 ? "no allocations after warm-up\n" : "FAILED: the second frame allocated\n");
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// packs images into a baked atlas file that BakedAtlas loads without decoding anything
+// build it together with the engine sources, it needs no window or gl context
+//
+// usage: atlas-baker [--page-size N] [--channels 1|4] [--padding N] [--no-mipmaps] <output file> <images...>
+//        atlas-baker --texture [--channels 1|4] <output file> <image>
+// each sprite is named by its image path as given on the command line
+// --texture bakes a single image into a page of its own size without padding, with its whole mip chain,
+// for StreamingTexture
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/ImageLoader.h"
+#include "../../include/Evolve/SkylinePacker.h"
+#include "../../include/Evolve/BakedAtlasFormat.h"
+
+namespace {
+	struct BakerPage {
+		Evolve::SkylinePacker Packer;
+
+		// every mip level, level 0 first
+		std::vector<std::vector<unsigned char>> Levels;
+	};
+
+	struct BakerSprite {
+		std::string Name;
+		uint32_t Page;
+		int32_t X, Y, Width, Height;
+	};
+
+	void printUsage() {
+		printf("usage: atlas-baker [--page-size N] [--channels 1|4] [--padding N] [--no-mipmaps] "
+			"<output file> <images...>\n"
+			"       atlas-baker --texture [--channels 1|4] <output file> <image>\n");
+	}
+
+	uint64_t alignOffset(uint64_t offset) {
+		return (offset + Evolve::BAKED_ATLAS_ALIGNMENT - 1) / Evolve::BAKED_ATLAS_ALIGNMENT * Evolve::BAKED_ATLAS_ALIGNMENT;
+	}
+
+	// halves the level with a box filter, an odd last row or column is averaged with itself
+	std::vector<unsigned char> downsampleLevel(const std::vector<unsigned char>& src, int width, int height,
+		int channels, int& newWidth, int& newHeight) {
+		
+		newWidth = std::max(1, width / 2);
+		newHeight = std::max(1, height / 2);
+
+		std::vector<unsigned char> dst((size_t) newWidth * newHeight * channels);
+
+		for (int y = 0; y < newHeight; y++) {
+			int y0 = std::min(y * 2, height - 1);
+			int y1 = std::min(y * 2 + 1, height - 1);
+
+			for (int x = 0; x < newWidth; x++) {
+				int x0 = std::min(x * 2, width - 1);
+				int x1 = std::min(x * 2 + 1, width - 1);
+
+				for (int c = 0; c < channels; c++) {
+					int sum =
+						src[((size_t) y0 * width + x0) * channels + c] +
+						src[((size_t) y0 * width + x1) * channels + c] +
+						src[((size_t) y1 * width + x0) * channels + c] +
+						src[((size_t) y1 * width + x1) * channels + c];
+
+					dst[((size_t) y * newWidth + x) * channels + c] = (unsigned char) ((sum + 2) / 4);
+				}
+			}
+		}
+
+		return dst;
+	}
+}
+
+int main(int argc, char** argv) {
+	int pageSize = 2048;
+	int channels = 4;
+	int padding = 1;
+	bool mipmaps = true;
+	bool textureMode = false;
+
+	int argIndex = 1;
+
+	for (; argIndex < argc && strncmp(argv[argIndex], "--", 2) == 0; argIndex++) {
+		std::string option = argv[argIndex];
+
+		if (option == "--no-mipmaps") {
+			mipmaps = false;
+		}
+		else if (option == "--texture") {
+			textureMode = true;
+		}
+		else if (argIndex + 1 < argc && option == "--page-size") {
+			pageSize = atoi(argv[++argIndex]);
+		}
+		else if (argIndex + 1 < argc && option == "--channels") {
+			channels = atoi(argv[++argIndex]);
+		}
+		else if (argIndex + 1 < argc && option == "--padding") {
+			padding = atoi(argv[++argIndex]);
+		}
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+
+	if (argc - argIndex < 2 || pageSize <= 0 || (channels != 1 && channels != 4) || padding < 0) {
+		printUsage();
+		return 1;
+	}
+
+	if (textureMode && argc - argIndex != 2) {
+		printUsage();
+		return 1;
+	}
+
+	std::string outputPath = argv[argIndex++];
+
+	int pageWidth = pageSize, pageHeight = pageSize;
+
+	if (textureMode) {
+		// the page takes the size of the image
+		Evolve::TextureData texture;
+		Evolve::ImageLoader::LoadTextureFromImage(argv[argIndex], texture, channels);
+
+		if (texture.data == nullptr) {
+			return 1;
+		}
+
+		pageWidth = texture.width;
+		pageHeight = texture.height;
+		Evolve::ImageLoader::FreeTexture(texture);
+		padding = 0;
+		mipmaps = true;
+	}
+
+	std::vector<BakerPage> pages;
+	std::vector<BakerSprite> sprites;
+
+	for (; argIndex < argc; argIndex++) {
+		std::string imagePath = argv[argIndex];
+
+		Evolve::TextureData texture;
+		Evolve::ImageLoader::LoadTextureFromImage(imagePath, texture, channels);
+
+		if (texture.data == nullptr) {
+			return 1;
+		}
+
+		int paddedWidth = texture.width + padding * 2;
+		int paddedHeight = texture.height + padding * 2;
+
+		if (paddedWidth > pageWidth || paddedHeight > pageHeight) {
+			printf("%s doesn't fit in a %d x %d page.\n", imagePath.c_str(), pageWidth, pageHeight);
+			Evolve::ImageLoader::FreeTexture(texture);
+			return 1;
+		}
+
+		size_t pageIndex = 0;
+		int x = 0, y = 0;
+
+		while (pageIndex < pages.size() && !pages[pageIndex].Packer.insert(paddedWidth, paddedHeight, x, y)) {
+			pageIndex++;
+		}
+
+		if (pageIndex == pages.size()) {
+			pages.emplace_back();
+			pages.back().Packer.init(pageWidth, pageHeight);
+			pages.back().Levels.emplace_back((size_t) pageWidth * pageHeight * channels, 0);
+			pages.back().Packer.insert(paddedWidth, paddedHeight, x, y);
+		}
+
+		// copy the image in, extruding its edge pixels into the padding
+		std::vector<unsigned char>& pixels = pages[pageIndex].Levels[0];
+
+		for (int row = 0; row < paddedHeight; row++) {
+			int srcRow = std::min(std::max(row - padding, 0), texture.height - 1);
+
+			for (int column = 0; column < paddedWidth; column++) {
+				int srcColumn = std::min(std::max(column - padding, 0), texture.width - 1);
+
+				memcpy(&pixels[((size_t) (y + row) * pageWidth + x + column) * channels],
+					&texture.data[((size_t) srcRow * texture.width + srcColumn) * channels], channels);
+			}
+		}
+
+		sprites.push_back({ imagePath, (uint32_t) pageIndex, x + padding, y + padding, texture.width, texture.height });
+		Evolve::ImageLoader::FreeTexture(texture);
+	}
+
+	uint32_t numMipLevels = 1;
+
+	if (mipmaps) {
+		for (int size = std::max(pageWidth, pageHeight); size > 1; size /= 2) {
+			numMipLevels++;
+		}
+	}
+
+	for (auto& page : pages) {
+		int width = pageWidth, height = pageHeight;
+
+		for (uint32_t level = 1; level < numMipLevels; level++) {
+			int newWidth, newHeight;
+			page.Levels.push_back(downsampleLevel(page.Levels.back(), width, height, channels, newWidth, newHeight));
+			width = newWidth;
+			height = newHeight;
+		}
+	}
+
+	// lay out the file
+	Evolve::BakedAtlasHeader header {};
+	memcpy(header.Magic, Evolve::BAKED_ATLAS_MAGIC, sizeof(header.Magic));
+	header.Version = Evolve::BAKED_ATLAS_VERSION;
+	header.PageWidth = pageWidth;
+	header.PageHeight = pageHeight;
+	header.ColorChannels = channels;
+	header.NumMipLevels = numMipLevels;
+	header.NumPages = (uint32_t) pages.size();
+	header.NumSprites = (uint32_t) sprites.size();
+
+	std::vector<Evolve::BakedAtlasSprite> spriteTable;
+	std::string nameBlob;
+
+	for (auto& sprite : sprites) {
+		spriteTable.push_back({ (uint32_t) nameBlob.size(), (uint32_t) sprite.Name.size(), sprite.Page,
+			sprite.X, sprite.Y, sprite.Width, sprite.Height });
+		nameBlob += sprite.Name;
+	}
+
+	header.SpriteTableOffset = alignOffset(sizeof(header));
+	header.NameBlobOffset = header.SpriteTableOffset + spriteTable.size() * sizeof(Evolve::BakedAtlasSprite);
+	header.NameBlobSize = nameBlob.size();
+	header.LevelTableOffset = alignOffset(header.NameBlobOffset + header.NameBlobSize);
+
+	std::vector<Evolve::BakedAtlasLevel> levelTable;
+	uint64_t offset = alignOffset(header.LevelTableOffset + 
+		(uint64_t) pages.size() * numMipLevels * sizeof(Evolve::BakedAtlasLevel));
+
+	for (auto& page : pages) {
+		uint32_t width = pageWidth, height = pageHeight;
+
+		for (auto& level : page.Levels) {
+			levelTable.push_back({ offset, level.size(), width, height });
+			offset = alignOffset(offset + level.size());
+
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+		}
+	}
+
+	std::ofstream file(outputPath, std::ios::binary);
+
+	if (file.fail()) {
+		printf("Failed to open %s.\n", outputPath.c_str());
+		return 1;
+	}
+
+	// pads the file up to the offset of the next section
+	auto seekTo = [&file](uint64_t target) {
+		static const char zeros[Evolve::BAKED_ATLAS_ALIGNMENT] = {};
+		file.write(zeros, (std::streamsize) (target - (uint64_t) file.tellp()));
+	};
+
+	file.write((const char*) &header, sizeof(header));
+
+	seekTo(header.SpriteTableOffset);
+	file.write((const char*) spriteTable.data(), spriteTable.size() * sizeof(Evolve::BakedAtlasSprite));
+	file.write(nameBlob.data(), nameBlob.size());
+
+	seekTo(header.LevelTableOffset);
+	file.write((const char*) levelTable.data(), levelTable.size() * sizeof(Evolve::BakedAtlasLevel));
+
+	size_t levelIndex = 0;
+
+	for (auto& page : pages) {
+		for (auto& level : page.Levels) {
+			seekTo(levelTable[levelIndex++].Offset);
+			file.write((const char*) level.data(), level.size());
+		}
+	}
+
+	if (file.fail()) {
+		printf("Failed to write %s.\n", outputPath.c_str());
+		return 1;
+	}
+
+	printf("Baked %zu sprites into %zu pages of %d x %d with %u mip levels.\n",
+		sprites.size(), pages.size(), pageWidth, pageHeight, numMipLevels);
+
+	return 0;
+}
\ No newline at end of file
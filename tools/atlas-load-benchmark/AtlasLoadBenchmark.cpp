@@ -0,0 +1,113 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// measures the start up cost of loading sprites from a baked atlas against decoding their pngs
+// build it together with the engine sources, it opens a window for the gl context
+//
+// usage: atlas-load-benchmark baked <baked atlas file>
+//        atlas-load-benchmark png <images...>
+// bake the atlas from the same images with the atlas baker to compare like with like
+// every run loads once in a fresh process, so the engine's caches are empty,
+// for a cold start also drop the os file cache before each run, on linux with
+// sync; echo 3 > /proc/sys/vm/drop_caches
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/ImageLoader.h"
+#include "../../include/Evolve/BakedAtlas.h"
+
+namespace {
+	void printUsage() {
+		printf("usage: atlas-load-benchmark baked <baked atlas file>\n"
+			"       atlas-load-benchmark png <images...>\n");
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		printUsage();
+		return 1;
+	}
+
+	std::string mode = argv[1];
+
+	if ((mode != "baked" && mode != "png") || (mode == "baked" && argc != 3)) {
+		printUsage();
+		return 1;
+	}
+
+	Evolve::Window window;
+
+	if (!window.init("Atlas load benchmark", false, 640, 360, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	// the uploads are finished too when the time is taken
+	glFinish();
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	Evolve::BakedAtlas atlas;
+	std::vector<Evolve::TextureData> textures;
+
+	if (mode == "baked") {
+		if (!atlas.loadFromFile(argv[2])) {
+			return 1;
+		}
+	}
+	else {
+		textures.resize(argc - 2);
+
+		for (int i = 2; i < argc; i++) {
+			Evolve::TextureData& texture = textures[i - 2];
+			Evolve::ImageLoader::LoadTextureFromImage(argv[i], texture, 4);
+
+			if (texture.data == nullptr) {
+				return 1;
+			}
+
+			Evolve::ImageLoader::BufferTextureData(texture);
+			Evolve::ImageLoader::FreeTexture(texture);
+		}
+	}
+
+	glFinish();
+
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	if (mode == "baked") {
+		printf("baked atlas: %zu pages loaded in %.3f ms\n", atlas.getNumPages(), milliseconds);
+	}
+	else {
+		printf("png: %zu images loaded in %.3f ms\n", textures.size(), milliseconds);
+	}
+
+	atlas.freeBakedAtlas();
+
+	for (auto& texture : textures) {
+		Evolve::ImageLoader::DeleteTexture(texture);
+	}
+
+	window.deleteWindow();
+	return 0;
+}
\ No newline at end of file
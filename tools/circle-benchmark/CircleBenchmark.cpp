@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// measures drawing 10k circles of mixed radii with ShapeRenderer
+// compared are the old tessellation (60 triangles per circle, cos and sin per vertex),
+// drawCircle with its cached unit circle tables and adaptive segment counts, and drawSmoothCircle
+// build it together with the engine sources, it opens a window for the gl context
+//
+// usage: circle-benchmark [path to engine-assets]
+// the draw and end times are cpu only, the frame time covers begin() to renderShapes() and waits with glFinish()
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/Camera.h"
+#include "../../include/Evolve/ShapeRenderer.h"
+
+namespace {
+	const int WINDOW_WIDTH = 1280, WINDOW_HEIGHT = 720;
+
+	const int NUM_CIRCLES = 10000;
+	const int NUM_WARMUP_FRAMES = 5;
+	const int NUM_FRAMES = 50;
+
+	enum class CircleMethod {
+		PER_VERTEX_SIN_COS,
+		TESSELLATION_TABLES,
+		SMOOTH
+	};
+
+	struct Circle {
+		Evolve::Position2D Center;
+		unsigned int Radius;
+	};
+
+	double millisecondsSince(const std::chrono::steady_clock::time_point& startTime) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	// the tessellation drawCircle had before the tables, a fixed step whatever the radius
+	void drawCirclePerVertex(Evolve::ShapeRenderer& renderer, const Circle& circle, const Evolve::ColorRgba& color) {
+		const int numTriangles = 60;
+
+		Evolve::Position2D previous = { circle.Center.X + (GLint) circle.Radius, circle.Center.Y };
+
+		for (int i = 1; i <= numTriangles; i++) {
+			double angle = (M_PI * 2.0) * ((double) i / numTriangles);
+
+			Evolve::Position2D next = {
+				(GLint) (circle.Center.X + cos(angle) * circle.Radius),
+				(GLint) (circle.Center.Y + sin(angle) * circle.Radius)
+			};
+
+			renderer.drawTriangle(circle.Center, previous, next, color);
+			previous = next;
+		}
+	}
+
+	void drawCircles(Evolve::ShapeRenderer& renderer, const std::vector<Circle>& circles, const CircleMethod method) {
+		const Evolve::ColorRgba color = { 80, 160, 255, 255 };
+
+		for (auto& circle : circles) {
+			switch (method) {
+			case CircleMethod::PER_VERTEX_SIN_COS:
+				drawCirclePerVertex(renderer, circle, color);
+				break;
+
+			case CircleMethod::TESSELLATION_TABLES:
+				renderer.drawCircle(circle.Center, circle.Radius, color);
+				break;
+
+			case CircleMethod::SMOOTH:
+				renderer.drawSmoothCircle(circle.Center, (float) circle.Radius, color);
+				break;
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string pathToAssets = argc > 1 ? argv[1] : "engine-assets";
+
+	Evolve::Window window;
+
+	if (!window.init("Circle benchmark", false, WINDOW_WIDTH, WINDOW_HEIGHT, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	Evolve::Camera camera;
+	camera.init({ WINDOW_WIDTH, WINDOW_HEIGHT });
+
+	Evolve::ShapeRenderer renderer;
+
+	if (!renderer.init(pathToAssets)) {
+		return 1;
+	}
+
+	// mostly small circles with some large ones, like particles and a few bodies
+	std::vector<Circle> circles(NUM_CIRCLES);
+	unsigned int seed = 1;
+
+	for (auto& circle : circles) {
+		seed = seed * 1664525u + 1013904223u;
+
+		circle.Center = { (GLint) ((seed >> 8) % WINDOW_WIDTH), (GLint) ((seed >> 16) % WINDOW_HEIGHT) };
+		circle.Radius = (seed >> 24) % 10 == 0 ? 50 + (seed >> 4) % 250 : 1 + (seed >> 4) % 20;
+	}
+
+	const struct {
+		const char* Name;
+		CircleMethod Method;
+	} methods[] = {
+		{ "per vertex sin and cos", CircleMethod::PER_VERTEX_SIN_COS },
+		{ "tessellation tables", CircleMethod::TESSELLATION_TABLES },
+		{ "smooth circles", CircleMethod::SMOOTH }
+	};
+
+	printf("%d circles, average of %d frames\n", NUM_CIRCLES, NUM_FRAMES);
+	printf("%-24s %10s %10s %10s %10s\n", "method", "draw ms", "end ms", "frame ms", "vertices");
+
+	for (auto& method : methods) {
+		double drawMilliseconds = 0.0, endMilliseconds = 0.0, frameMilliseconds = 0.0;
+
+		for (int frame = 0; frame < NUM_WARMUP_FRAMES + NUM_FRAMES; frame++) {
+			SDL_PumpEvents();
+			window.clearScreen(GL_COLOR_BUFFER_BIT);
+			glFinish();
+
+			auto frameStartTime = std::chrono::steady_clock::now();
+
+			renderer.begin();
+			drawCircles(renderer, circles, method.Method);
+
+			double drawTime = millisecondsSince(frameStartTime);
+			auto endStartTime = std::chrono::steady_clock::now();
+
+			renderer.end();
+
+			double endTime = millisecondsSince(endStartTime);
+
+			renderer.renderShapes(camera);
+			glFinish();
+
+			if (frame >= NUM_WARMUP_FRAMES) {
+				drawMilliseconds += drawTime;
+				endMilliseconds += endTime;
+				frameMilliseconds += millisecondsSince(frameStartTime);
+			}
+		}
+
+		printf("%-24s %10.3f %10.3f %10.3f %10zu\n", method.Name, drawMilliseconds / NUM_FRAMES,
+			endMilliseconds / NUM_FRAMES, frameMilliseconds / NUM_FRAMES, renderer.getStats().NumVertices);
+	}
+
+	renderer.freeShapeRenderer();
+	window.deleteWindow();
+	return 0;
+}
\ No newline at end of file
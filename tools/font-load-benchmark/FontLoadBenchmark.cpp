@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// measures the start up time of 20 font and size combinations
+// build it together with the engine sources and FreeType, it opens a window for the gl context
+//
+// usage: font-load-benchmark <font file> [second font file]
+// with two files each gets 10 sizes, otherwise the one file gets all 20
+// compared are a FreeType library and face opened per font with every glyph rendered up front,
+// as Font did before sharing faces, then Font::initFromFontFile per combination and 
+// Font::initSizesFromFontFile per file, both followed by rasterizing the printable ascii glyphs
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/Font.h"
+
+namespace {
+	const unsigned int NUM_SIZES = 20;
+	const unsigned int FIRST_SIZE = 12, SIZE_STEP = 2;
+
+	const int NUM_RUNS = 10;
+
+	struct FontFileSizes {
+		const char* FilePath;
+		std::vector<unsigned int> Sizes;
+	};
+
+	double millisecondsSince(const std::chrono::steady_clock::time_point& startTime) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	// the cost the fonts had before, without the gl uploads
+	bool loadSeparately(const std::vector<FontFileSizes>& files) {
+		for (auto& file : files) {
+			for (unsigned int size : file.Sizes) {
+				FT_Library library;
+
+				if (FT_Init_FreeType(&library) != 0) {
+					return false;
+				}
+
+				FT_Face face;
+
+				if (FT_New_Face(library, file.FilePath, 0, &face) != 0) {
+					FT_Done_FreeType(library);
+					return false;
+				}
+
+				FT_Set_Pixel_Sizes(face, 0, size);
+
+				for (FT_ULong codePoint = 0; codePoint < 256; codePoint++) {
+					FT_Load_Char(face, codePoint, FT_LOAD_RENDER);
+				}
+
+				FT_Done_Face(face);
+				FT_Done_FreeType(library);
+			}
+		}
+
+		return true;
+	}
+
+	bool loadPerFont(const std::vector<FontFileSizes>& files, std::vector<Evolve::Font>& fonts) {
+		size_t fontIndex = 0;
+
+		for (auto& file : files) {
+			for (unsigned int size : file.Sizes) {
+				if (!fonts[fontIndex++].initFromFontFile("benchmark", file.FilePath, size)) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool loadPerFile(const std::vector<FontFileSizes>& files, std::vector<Evolve::Font>& fonts) {
+		size_t fontIndex = 0;
+
+		for (auto& file : files) {
+			std::vector<Evolve::Font*> filesFonts;
+
+			for (size_t i = 0; i < file.Sizes.size(); i++) {
+				filesFonts.push_back(&fonts[fontIndex++]);
+			}
+
+			if (!Evolve::Font::initSizesFromFontFile("benchmark", file.FilePath, filesFonts, file.Sizes)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void preloadAscii(std::vector<Evolve::Font>& fonts) {
+		std::string ascii;
+
+		for (char c = ' '; c <= '~'; c++) {
+			ascii += c;
+		}
+
+		for (auto& font : fonts) {
+			font.preloadGlyphs(ascii.c_str());
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2 && argc != 3) {
+		printf("usage: font-load-benchmark <font file> [second font file]\n");
+		return 1;
+	}
+
+	std::vector<FontFileSizes> files(argc - 1);
+
+	for (unsigned int i = 0; i < NUM_SIZES; i++) {
+		FontFileSizes& file = files[i % files.size()];
+
+		file.FilePath = argv[1 + i % files.size()];
+		file.Sizes.push_back(FIRST_SIZE + i * SIZE_STEP);
+	}
+
+	Evolve::Window window;
+
+	if (!window.init("Font load benchmark", false, 640, 360, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	double separateMilliseconds = 0.0;
+	double perFontMilliseconds = 0.0, perFontAsciiMilliseconds = 0.0;
+	double perFileMilliseconds = 0.0, perFileAsciiMilliseconds = 0.0;
+
+	for (int run = 0; run < NUM_RUNS; run++) {
+		auto startTime = std::chrono::steady_clock::now();
+
+		if (!loadSeparately(files)) {
+			return 1;
+		}
+
+		separateMilliseconds += millisecondsSince(startTime);
+
+		// the faces are closed with their last font, so every run opens the files again
+		for (int perFile = 0; perFile < 2; perFile++) {
+			std::vector<Evolve::Font> fonts(NUM_SIZES);
+
+			startTime = std::chrono::steady_clock::now();
+
+			if (!(perFile ? loadPerFile(files, fonts) : loadPerFont(files, fonts))) {
+				return 1;
+			}
+
+			double loadTime = millisecondsSince(startTime);
+
+			preloadAscii(fonts);
+			glFinish();
+
+			double asciiTime = millisecondsSince(startTime);
+
+			(perFile ? perFileMilliseconds : perFontMilliseconds) += loadTime;
+			(perFile ? perFileAsciiMilliseconds : perFontAsciiMilliseconds) += asciiTime;
+
+			for (auto& font : fonts) {
+				font.deleteFont();
+			}
+		}
+	}
+
+	printf("%u fonts from %zu file(s), average of %d runs\n", NUM_SIZES, files.size(), NUM_RUNS);
+	printf("%-36s %10s %16s\n", "", "load ms", "with ascii ms");
+	printf("%-36s %10s %16.3f\n", "library and face per font, eager", "", separateMilliseconds / NUM_RUNS);
+	printf("%-36s %10.3f %16.3f\n", "Font::initFromFontFile per font", 
+		perFontMilliseconds / NUM_RUNS, perFontAsciiMilliseconds / NUM_RUNS);
+	printf("%-36s %10.3f %16.3f\n", "Font::initSizesFromFontFile per file", 
+		perFileMilliseconds / NUM_RUNS, perFileAsciiMilliseconds / NUM_RUNS);
+
+	window.deleteWindow();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// compares sorting pointers to whole glyphs, as TextureRenderer::end() did, with sorting (key, index) pairs
+// and gathering the vertices in one pass, the way it does now
+// build it together with the engine sources, it needs no window or gl context
+//
+// usage: sort-benchmark [pointer|key] [number of glyphs]
+// runs both ways by default with 100k glyphs, running one at a time under
+// perf stat -e L1-dcache-load-misses,LLC-load-misses shows the cache misses of each
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Vertex2D.h"
+#include "../../include/Evolve/SpriteInstance.h"
+#include "../../include/Evolve/RadixSort.h"
+
+namespace {
+	const int NUM_RUNS = 50;
+	const unsigned int NUM_TEXTURES = 64;
+
+	// the glyph TextureRenderer used to sort, four full vertices next to the sort fields
+	struct PointerGlyph {
+		GLuint TextureID;
+		int Depth;
+		Evolve::Vertex2D BottomLeft, BottomRight, TopRight, TopLeft;
+	};
+
+	// what the key sort reads, the compact sort data and the sprites are kept apart
+	struct GlyphSortData {
+		GLuint TextureID;
+		int Depth;
+	};
+
+	struct Timings {
+		double SortMilliseconds = 0.0;
+		double GatherMilliseconds = 0.0;
+	};
+
+	double millisecondsSince(const std::chrono::steady_clock::time_point& startTime) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	void writeQuadVertices(const Evolve::SpriteInstance& glyph, Evolve::Vertex2D* destination) {
+		Evolve::Vertex2D vertex;
+		vertex.setColor(glyph.Color);
+
+		const Evolve::UvDimension& uv = glyph.Uv;
+
+		vertex.setPosition(glyph.Left, glyph.Bottom);
+		vertex.setTextureCoords(uv.BottomLeftX, uv.BottomLeftY);
+		destination[0] = vertex;
+
+		vertex.setPosition(glyph.Right, glyph.Bottom);
+		vertex.setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY);
+		destination[1] = vertex;
+
+		vertex.setPosition(glyph.Right, glyph.Top);
+		vertex.setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY + uv.Height);
+		destination[2] = vertex;
+
+		vertex.setPosition(glyph.Left, glyph.Top);
+		vertex.setTextureCoords(uv.BottomLeftX, uv.BottomLeftY + uv.Height);
+		destination[3] = vertex;
+	}
+
+	void makeSprites(const size_t numGlyphs, std::vector<Evolve::SpriteInstance>& sprites,
+		std::vector<GlyphSortData>& sortData) {
+
+		sprites.resize(numGlyphs);
+		sortData.resize(numGlyphs);
+
+		unsigned int seed = 1;
+
+		for (size_t i = 0; i < numGlyphs; i++) {
+			seed = seed * 1664525u + 1013904223u;
+
+			int x = (int) ((i * 37) % 1264), y = (int) ((i * 53) % 704);
+
+			sprites[i].set(Evolve::RectDimension(Evolve::Origin::BOTTOM_LEFT, x, y, 16, 16),
+				{ 0.0f, 0.0f, 1.0f, 1.0f }, { 255, 255, 255, 255 });
+			sortData[i] = { 1 + (seed >> 16) % NUM_TEXTURES, (int) ((seed >> 8) % 8) };
+		}
+	}
+
+	Timings runPointerSort(const std::vector<Evolve::SpriteInstance>& sprites, 
+		const std::vector<GlyphSortData>& sortData, std::vector<Evolve::Vertex2D>& vertices) {
+
+		std::vector<PointerGlyph> glyphs(sprites.size());
+
+		for (size_t i = 0; i < sprites.size(); i++) {
+			Evolve::Vertex2D quad[4];
+			writeQuadVertices(sprites[i], quad);
+
+			glyphs[i] = { sortData[i].TextureID, sortData[i].Depth, quad[0], quad[1], quad[2], quad[3] };
+		}
+
+		std::vector<PointerGlyph*> glyphPointers(glyphs.size());
+		Timings timings;
+
+		for (int run = 0; run < NUM_RUNS; run++) {
+			for (size_t i = 0; i < glyphs.size(); i++) {
+				glyphPointers[i] = &glyphs[i];
+			}
+
+			auto startTime = std::chrono::steady_clock::now();
+
+			std::stable_sort(glyphPointers.begin(), glyphPointers.end(), 
+				[](const PointerGlyph* a, const PointerGlyph* b) { return a->TextureID < b->TextureID; });
+
+			timings.SortMilliseconds += millisecondsSince(startTime);
+			startTime = std::chrono::steady_clock::now();
+
+			vertices.resize(glyphs.size() * 4);
+
+			for (size_t i = 0; i < glyphPointers.size(); i++) {
+				vertices[i * 4] = glyphPointers[i]->BottomLeft;
+				vertices[i * 4 + 1] = glyphPointers[i]->BottomRight;
+				vertices[i * 4 + 2] = glyphPointers[i]->TopRight;
+				vertices[i * 4 + 3] = glyphPointers[i]->TopLeft;
+			}
+
+			timings.GatherMilliseconds += millisecondsSince(startTime);
+		}
+
+		return timings;
+	}
+
+	Timings runKeySort(const std::vector<Evolve::SpriteInstance>& sprites,
+		const std::vector<GlyphSortData>& sortData, std::vector<Evolve::Vertex2D>& vertices) {
+
+		std::vector<Evolve::SortEntry> sortEntries, sortScratch;
+		Timings timings;
+
+		for (int run = 0; run < NUM_RUNS; run++) {
+			auto startTime = std::chrono::steady_clock::now();
+
+			sortEntries.resize(sortData.size());
+
+			for (size_t i = 0; i < sortData.size(); i++) {
+				sortEntries[i] = { sortData[i].TextureID, (uint32_t) i };
+			}
+
+			Evolve::radixSortEntries(sortEntries, sortScratch);
+
+			timings.SortMilliseconds += millisecondsSince(startTime);
+			startTime = std::chrono::steady_clock::now();
+
+			vertices.resize(sprites.size() * 4);
+
+			for (size_t i = 0; i < sortEntries.size(); i++) {
+				writeQuadVertices(sprites[sortEntries[i].Index], &vertices[i * 4]);
+			}
+
+			timings.GatherMilliseconds += millisecondsSince(startTime);
+		}
+
+		return timings;
+	}
+
+	void printTimings(const char* name, const Timings& timings) {
+		printf("%-8s sort %8.3f ms   gather %8.3f ms   total %8.3f ms\n", name,
+			timings.SortMilliseconds / NUM_RUNS, timings.GatherMilliseconds / NUM_RUNS,
+			(timings.SortMilliseconds + timings.GatherMilliseconds) / NUM_RUNS);
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string which = argc > 1 ? argv[1] : "both";
+	size_t numGlyphs = argc > 2 ? (size_t) atol(argv[2]) : 100000;
+
+	if (which != "both" && which != "pointer" && which != "key") {
+		printf("usage: sort-benchmark [pointer|key] [number of glyphs]\n");
+		return 1;
+	}
+
+	std::vector<Evolve::SpriteInstance> sprites;
+	std::vector<GlyphSortData> sortData;
+	makeSprites(numGlyphs, sprites, sortData);
+
+	printf("%zu glyphs, %u textures, average of %d runs\n", numGlyphs, NUM_TEXTURES, NUM_RUNS);
+
+	std::vector<Evolve::Vertex2D> pointerVertices, keyVertices;
+
+	if (which != "key") {
+		printTimings("pointer", runPointerSort(sprites, sortData, pointerVertices));
+	}
+
+	if (which != "pointer") {
+		printTimings("key", runKeySort(sprites, sortData, keyVertices));
+	}
+
+	// both sorts are stable, so they must gather the same vertices
+	if (which == "both" && memcmp(pointerVertices.data(), keyVertices.data(), 
+		keyVertices.size() * sizeof(Evolve::Vertex2D)) != 0) {
+
+		printf("FAILED: the two ways gathered different vertices\n");
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// measures wrapping and aligning 100 KB of text with TextLayout
+// build it together with the engine sources and FreeType, it opens a window for the gl context
+//
+// usage: text-layout-benchmark <font file> [text file]
+// without a text file, 100 KB of filler text is generated
+// the baseline wraps the way it was done without TextLayout, measuring the line with getLineWidth for every word
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/Font.h"
+#include "../../include/Evolve/TextLayout.h"
+
+namespace {
+	const size_t GENERATED_TEXT_SIZE = 100 * 1024;
+	const unsigned int FONT_SIZE = 24;
+	const int MAX_WIDTH = 600;
+	const int NUM_RUNS = 20;
+
+	double millisecondsSince(const std::chrono::steady_clock::time_point& startTime) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	std::string makeText() {
+		const char* words[] = { "lorem", "ipsum", "dolor", "sit", "amet,", "consectetur", "adipiscing", "elit,",
+			"sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et", "dolore", "magna", "aliqua." };
+
+		std::string text;
+		unsigned int seed = 1;
+
+		while (text.size() < GENERATED_TEXT_SIZE) {
+			seed = seed * 1664525u + 1013904223u;
+			text += words[(seed >> 16) % (sizeof(words) / sizeof(words[0]))];
+
+			// a paragraph every few hundred words
+			text += (seed >> 8) % 300 == 0 ? '\n' : ' ';
+		}
+
+		return text;
+	}
+
+	bool readText(const char* filePath, std::string& text) {
+		std::ifstream file(filePath, std::ios::binary);
+
+		if (!file) {
+			return false;
+		}
+
+		text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	// greedy wrapping at spaces, measuring the whole line again for every word
+	size_t wrapWithLineWidths(const Evolve::Font& font, const std::string& text) {
+		size_t numLines = 0;
+		std::string line, candidate;
+
+		size_t wordBegin = 0;
+
+		while (wordBegin <= text.size()) {
+			size_t wordEnd = text.find_first_of(" \n", wordBegin);
+
+			if (wordEnd == std::string::npos) {
+				wordEnd = text.size();
+			}
+
+			candidate = line.empty() ? text.substr(wordBegin, wordEnd - wordBegin) :
+				line + " " + text.substr(wordBegin, wordEnd - wordBegin);
+
+			if (!line.empty() && (int) font.getLineWidth(candidate.c_str()) > MAX_WIDTH) {
+				numLines++;
+				line = text.substr(wordBegin, wordEnd - wordBegin);
+			}
+			else {
+				line = candidate;
+			}
+
+			if (wordEnd == text.size() || text[wordEnd] == '\n') {
+				numLines++;
+				line.clear();
+			}
+
+			wordBegin = wordEnd + 1;
+		}
+
+		return numLines;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc != 2 && argc != 3) {
+		printf("usage: text-layout-benchmark <font file> [text file]\n");
+		return 1;
+	}
+
+	std::string text;
+
+	if (argc == 3) {
+		if (!readText(argv[2], text)) {
+			printf("Failed to read %s\n", argv[2]);
+			return 1;
+		}
+	}
+	else {
+		text = makeText();
+	}
+
+	Evolve::Window window;
+
+	if (!window.init("Text layout benchmark", false, 640, 360, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	Evolve::Font font;
+
+	if (!font.initFromFontFile("benchmark", argv[1], FONT_SIZE)) {
+		return 1;
+	}
+
+	// rasterizing the glyphs is left out of the timings
+	font.preloadGlyphs(text.c_str());
+
+	printf("%zu bytes of text, %d pixels wide, average of %d runs\n", text.size(), MAX_WIDTH, NUM_RUNS);
+	printf("%-30s %10s %8s\n", "", "ms", "lines");
+
+	auto startTime = std::chrono::steady_clock::now();
+	size_t numLines = wrapWithLineWidths(font, text);
+
+	printf("%-30s %10.3f %8zu\n", "getLineWidth per word", millisecondsSince(startTime), numLines);
+
+	const struct {
+		const char* Name;
+		Evolve::TextAlignment Alignment;
+		bool Kerning;
+	} layouts[] = {
+		{ "TextLayout left", Evolve::TextAlignment::LEFT, true },
+		{ "TextLayout left, no kerning", Evolve::TextAlignment::LEFT, false },
+		{ "TextLayout center", Evolve::TextAlignment::CENTER, true },
+		{ "TextLayout right", Evolve::TextAlignment::RIGHT, true },
+		{ "TextLayout justify", Evolve::TextAlignment::JUSTIFY, true }
+	};
+
+	int result = 0;
+
+	for (auto& layoutCase : layouts) {
+		Evolve::TextLayout layout;
+		Evolve::TextLayoutOptions options;
+		options.Alignment = layoutCase.Alignment;
+		options.Kerning = layoutCase.Kerning;
+
+		double milliseconds = 0.0;
+
+		for (int run = 0; run < NUM_RUNS; run++) {
+			// an unchanged layout isn't laid out again, so the width changes between runs
+			options.MaxWidth = MAX_WIDTH - run % 2;
+
+			startTime = std::chrono::steady_clock::now();
+			layout.update(font, text.c_str(), options);
+			milliseconds += millisecondsSince(startTime);
+		}
+
+		for (auto& line : layout.getLines()) {
+			if (line.Width > options.MaxWidth) {
+				printf("FAILED: a line of %s is %d pixels wide\n", layoutCase.Name, line.Width);
+				result = 1;
+				break;
+			}
+		}
+
+		printf("%-30s %10.3f %8zu\n", layoutCase.Name, milliseconds / NUM_RUNS, layout.getLines().size());
+	}
+
+	font.deleteFont();
+	window.deleteWindow();
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,375 @@
+/*
+Copyright (c) 2024 Raquibul Islam
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// measures the frame time of TextureRenderer at 1k, 10k and 100k sprites for every batching and upload mode,
+// next to the old path rebuilt here, which generated an ibo per batch and rebuilt its indices every frame
+// build it together with the engine sources, it opens a window for the gl context
+//
+// usage: texture-renderer-benchmark [path to engine-assets]
+// the cpu time covers begin() to renderTextures(), the frame time also waits for the gpu with glFinish()
+// swapping is left out, so vsync doesn't cap the numbers
+
+#define SDL_MAIN_HANDLED
+
+#include "../../include/Evolve/Window.h"
+#include "../../include/Evolve/Camera.h"
+#include "../../include/Evolve/TextureRenderer.h"
+#include "../../include/Evolve/GlslProgram.h"
+
+namespace {
+	const int WINDOW_WIDTH = 1280, WINDOW_HEIGHT = 720;
+
+	const int NUM_WARMUP_FRAMES = 10;
+	const int NUM_FRAMES = 100;
+
+	const size_t SPRITE_COUNTS[] = { 1000, 10000, 100000 };
+
+	// the sprites cycle through the textures, so the single texture paths make a batch per texture
+	const int NUM_TEXTURES = 32;
+
+	struct BenchmarkMode {
+		const char* Name;
+		Evolve::TextureBatchingMode BatchingMode;
+		Evolve::BufferUploadMode UploadMode;
+	};
+
+	const BenchmarkMode MODES[] = {
+		{ "single texture, buffer sub data", Evolve::TextureBatchingMode::SINGLE_TEXTURE, Evolve::BufferUploadMode::BUFFER_SUB_DATA },
+		{ "single texture, mapped ring", Evolve::TextureBatchingMode::SINGLE_TEXTURE, Evolve::BufferUploadMode::MAPPED_RING },
+		{ "multi texture, mapped ring", Evolve::TextureBatchingMode::MULTI_TEXTURE, Evolve::BufferUploadMode::MAPPED_RING },
+		{ "instanced, mapped ring", Evolve::TextureBatchingMode::INSTANCED, Evolve::BufferUploadMode::MAPPED_RING }
+	};
+
+	// TextureRenderer as it was before the persistent buffers, kept to compare against
+	// every frame the vertices are gathered into a new vector, the vbo is respecified,
+	// and every batch gets a freshly generated ibo filled with indices built again
+	class PerFrameBufferRenderer {
+	public:
+		~PerFrameBufferRenderer() {
+			deleteIbos();
+
+			if (vboID_ != 0) {
+				glDeleteBuffers(1, &vboID_);
+			}
+
+			if (vaoID_ != 0) {
+				glDeleteVertexArrays(1, &vaoID_);
+			}
+
+			shader_.freeProgram();
+		}
+
+		bool init(const std::string& pathToAssets) {
+			if (!shader_.compileAndLinkShaders(pathToAssets + "/shaders/texture_shader.vert", 
+				pathToAssets + "/shaders/texture_shader.frag")) {
+				return false;
+			}
+
+			glGenVertexArrays(1, &vaoID_);
+			glGenBuffers(1, &vboID_);
+
+			glBindVertexArray(vaoID_);
+			glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+
+			glEnableVertexAttribArray(0);
+			glEnableVertexAttribArray(1);
+			glEnableVertexAttribArray(2);
+
+			glVertexAttribPointer(0, 2, GL_INT, GL_FALSE, sizeof(Evolve::Vertex2D), 
+				(void*) offsetof(Evolve::Vertex2D, Position));
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Evolve::Vertex2D), 
+				(void*) offsetof(Evolve::Vertex2D, Color));
+			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Evolve::Vertex2D), 
+				(void*) offsetof(Evolve::Vertex2D, TextureCoords));
+
+			glBindVertexArray(0);
+			return true;
+		}
+
+		void begin() {
+			glyphs_.clear();
+			glyphPointers_.clear();
+			batches_.clear();
+			deleteIbos();
+		}
+
+		void draw(const Evolve::RectDimension& destRect, const Evolve::UvDimension& uv, 
+			GLuint textureID, const Evolve::ColorRgba& color, int depth) {
+
+			Glyph glyph;
+			glyph.TextureID = textureID;
+			glyph.Depth = depth;
+
+			const GLint left = destRect.getLeft(), right = destRect.getRight();
+			const GLint bottom = destRect.getBottom(), top = destRect.getTop();
+
+			glyph.Vertices[0].setPosition(left, bottom);
+			glyph.Vertices[0].setTextureCoords(uv.BottomLeftX, uv.BottomLeftY);
+
+			glyph.Vertices[1].setPosition(right, bottom);
+			glyph.Vertices[1].setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY);
+
+			glyph.Vertices[2].setPosition(right, top);
+			glyph.Vertices[2].setTextureCoords(uv.BottomLeftX + uv.Width, uv.BottomLeftY + uv.Height);
+
+			glyph.Vertices[3].setPosition(left, top);
+			glyph.Vertices[3].setTextureCoords(uv.BottomLeftX, uv.BottomLeftY + uv.Height);
+
+			for (auto& vertex : glyph.Vertices) {
+				vertex.setColor(color);
+			}
+
+			glyphs_.push_back(glyph);
+		}
+
+		void end() {
+			if (glyphs_.empty()) {
+				return;
+			}
+
+			glyphPointers_.resize(glyphs_.size());
+
+			for (size_t i = 0; i < glyphs_.size(); i++) {
+				glyphPointers_[i] = &glyphs_[i];
+			}
+
+			std::stable_sort(glyphPointers_.begin(), glyphPointers_.end(), 
+				[](const Glyph* a, const Glyph* b) { return a->TextureID < b->TextureID; });
+
+			std::vector<Evolve::Vertex2D> vertices(glyphPointers_.size() * 4);
+
+			for (size_t i = 0; i < glyphPointers_.size(); i++) {
+				for (int vertex = 0; vertex < 4; vertex++) {
+					vertices[i * 4 + vertex] = glyphPointers_[i]->Vertices[vertex];
+				}
+			}
+
+			glBindBuffer(GL_ARRAY_BUFFER, vboID_);
+			glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Evolve::Vertex2D), nullptr, GL_DYNAMIC_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Evolve::Vertex2D), vertices.data());
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			std::vector<GLuint> indices(glyphPointers_.size() * 6);
+
+			for (size_t i = 0; i < glyphPointers_.size(); i++) {
+				GLuint vertex = (GLuint) i * 4;
+
+				indices[i * 6] = vertex;
+				indices[i * 6 + 1] = vertex + 1;
+				indices[i * 6 + 2] = vertex + 2;
+				indices[i * 6 + 3] = vertex;
+				indices[i * 6 + 4] = vertex + 3;
+				indices[i * 6 + 5] = vertex + 2;
+
+				if (i == 0 || glyphPointers_[i]->TextureID != glyphPointers_[i - 1]->TextureID) {
+					batches_.push_back({ (unsigned int) i * 6, 0, glyphPointers_[i]->TextureID, 0 });
+				}
+
+				batches_.back().NumIndices += 6;
+			}
+
+			iboIDs_.resize(batches_.size());
+			glGenBuffers((GLsizei) iboIDs_.size(), iboIDs_.data());
+
+			for (size_t i = 0; i < batches_.size(); i++) {
+				Batch& batch = batches_[i];
+				batch.IboID = iboIDs_[i];
+
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.IboID);
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, batch.NumIndices * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, batch.NumIndices * sizeof(GLuint), &indices[batch.Offset]);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			}
+		}
+
+		void renderTextures(Evolve::Camera& camera) {
+			shader_.useProgram();
+			camera.sendMatrixDataToShader(shader_);
+
+			glActiveTexture(GL_TEXTURE0);
+			glUniform1i(shader_.getUniformLocation(std::string("u_imageSampler")), 0);
+
+			glBindVertexArray(vaoID_);
+
+			for (auto& batch : batches_) {
+				glBindTexture(GL_TEXTURE_2D, batch.TextureID);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.IboID);
+				glDrawElements(GL_TRIANGLES, batch.NumIndices, GL_UNSIGNED_INT, nullptr);
+			}
+
+			glBindVertexArray(0);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			shader_.unuseProgram();
+		}
+
+		unsigned int getNumDrawCalls() const { return (unsigned int) batches_.size(); }
+
+	private:
+		struct Glyph {
+			GLuint TextureID;
+			int Depth;
+			Evolve::Vertex2D Vertices[4];
+		};
+
+		struct Batch {
+			unsigned int Offset, NumIndices;
+			GLuint TextureID, IboID;
+		};
+
+		Evolve::GlslProgram shader_;
+		GLuint vaoID_ = 0, vboID_ = 0;
+
+		std::vector<Glyph> glyphs_;
+		std::vector<Glyph*> glyphPointers_;
+		std::vector<Batch> batches_;
+		std::vector<GLuint> iboIDs_;
+
+		void deleteIbos() {
+			if (!iboIDs_.empty()) {
+				glDeleteBuffers((GLsizei) iboIDs_.size(), iboIDs_.data());
+				iboIDs_.clear();
+			}
+		}
+	};
+
+	unsigned int getNumDrawCalls(const Evolve::TextureRenderer& renderer) { 
+		return renderer.getStats().NumDrawCalls; 
+	}
+
+	unsigned int getNumDrawCalls(const PerFrameBufferRenderer& renderer) { 
+		return renderer.getNumDrawCalls(); 
+	}
+
+	double millisecondsSince(const std::chrono::steady_clock::time_point& startTime) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	}
+
+	template <typename Renderer>
+	void drawSprites(Renderer& renderer, const size_t numSprites, const GLuint* textureIDs) {
+		const Evolve::UvDimension uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+		const Evolve::ColorRgba color = { 255, 255, 255, 255 };
+
+		renderer.begin();
+
+		for (size_t i = 0; i < numSprites; i++) {
+			int x = (int) ((i * 37) % (WINDOW_WIDTH - 16));
+			int y = (int) ((i * 53) % (WINDOW_HEIGHT - 16));
+
+			renderer.draw(Evolve::RectDimension(Evolve::Origin::BOTTOM_LEFT, x, y, 16, 16), uv,
+				textureIDs[i % NUM_TEXTURES], color, (int) (i % 8));
+		}
+
+		renderer.end();
+	}
+
+	template <typename Renderer>
+	void runFrames(const char* name, Renderer& renderer, Evolve::Window& window, Evolve::Camera& camera,
+		const GLuint* textureIDs) {
+
+		for (size_t numSprites : SPRITE_COUNTS) {
+			double cpuMilliseconds = 0.0, frameMilliseconds = 0.0;
+
+			for (int frame = 0; frame < NUM_WARMUP_FRAMES + NUM_FRAMES; frame++) {
+				SDL_PumpEvents();
+				window.clearScreen(GL_COLOR_BUFFER_BIT);
+				glFinish();
+
+				auto startTime = std::chrono::steady_clock::now();
+
+				drawSprites(renderer, numSprites, textureIDs);
+				renderer.renderTextures(camera);
+
+				double cpuTime = millisecondsSince(startTime);
+
+				glFinish();
+
+				double frameTime = millisecondsSince(startTime);
+
+				if (frame >= NUM_WARMUP_FRAMES) {
+					cpuMilliseconds += cpuTime;
+					frameMilliseconds += frameTime;
+				}
+			}
+
+			printf("%-34s %8zu %12.3f %14.3f %12u\n", name, numSprites,
+				cpuMilliseconds / NUM_FRAMES, frameMilliseconds / NUM_FRAMES, getNumDrawCalls(renderer));
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string pathToAssets = argc > 1 ? argv[1] : "engine-assets";
+
+	Evolve::Window window;
+
+	if (!window.init("TextureRenderer benchmark", false, WINDOW_WIDTH, WINDOW_HEIGHT, { 0, 0, 0, 255 })) {
+		return 1;
+	}
+
+	Evolve::Camera camera;
+	camera.init({ WINDOW_WIDTH, WINDOW_HEIGHT });
+
+	// small textures of one color each, what they show doesn't matter
+	GLuint textureIDs[NUM_TEXTURES] = {};
+	glGenTextures(NUM_TEXTURES, textureIDs);
+
+	for (int i = 0; i < NUM_TEXTURES; i++) {
+		std::vector<unsigned char> pixels(16 * 16 * 4, (unsigned char) (128 + i * 4));
+
+		glBindTexture(GL_TEXTURE_2D, textureIDs[i]);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 16, 16, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	printf("%-34s %8s %12s %14s %12s\n", "mode", "sprites", "cpu ms", "frame ms", "draw calls");
+
+	{
+		PerFrameBufferRenderer renderer;
+
+		if (!renderer.init(pathToAssets)) {
+			return 1;
+		}
+
+		runFrames("old, an ibo per batch every frame", renderer, window, camera, textureIDs);
+	}
+
+	for (auto& mode : MODES) {
+		Evolve::TextureRenderer renderer;
+
+		if (!renderer.init(pathToAssets, mode.BatchingMode, mode.UploadMode)) {
+			return 1;
+		}
+
+		runFrames(mode.Name, renderer, window, camera, textureIDs);
+		renderer.freeTextureRenderer();
+	}
+
+	glDeleteTextures(NUM_TEXTURES, textureIDs);
+
+	window.deleteWindow();
+	return 0;
+}
\ No newline at end of file